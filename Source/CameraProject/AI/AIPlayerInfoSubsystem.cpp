@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AIPlayerInfoSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "CameraLockOnComponent.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Player Info Refresh"), STAT_AIPlayerInfoRefresh, STATGROUP_CameraProject);
+
+TConstArrayView<FAIPlayerInfo> UAIPlayerInfoSubsystem::GetPlayers()
+{
+	RefreshIfStale();
+
+	return Players;
+}
+
+const FAIPlayerInfo* UAIPlayerInfoSubsystem::FindClosestPlayer(const FVector& Location, double* OutDistance)
+{
+	RefreshIfStale();
+
+	const FAIPlayerInfo* ClosestPlayer = nullptr;
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+
+	for (const FAIPlayerInfo& Player : Players)
+	{
+		const double DistanceSquared = FVector::DistSquared(Location, Player.Location);
+
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestPlayer = &Player;
+			ClosestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	if (OutDistance && ClosestPlayer)
+	{
+		*OutDistance = FMath::Sqrt(ClosestDistanceSquared);
+	}
+
+	return ClosestPlayer;
+}
+
+void UAIPlayerInfoSubsystem::RefreshIfStale()
+{
+	if (LastRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AIPlayerInfoRefresh);
+
+	LastRefreshFrame = GFrameCounter;
+
+	// keep the previous entries around so we only look for lock-on components on new pawns
+	TArray<FAIPlayerInfo> PreviousPlayers = MoveTemp(Players);
+	Players.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+		if (!PlayerPawn)
+		{
+			continue;
+		}
+
+		FAIPlayerInfo& Player = Players.AddDefaulted_GetRef();
+		Player.Pawn = PlayerPawn;
+		Player.Location = PlayerPawn->GetActorLocation();
+		Player.Velocity = PlayerPawn->GetVelocity();
+
+		const FAIPlayerInfo* Previous = PreviousPlayers.FindByPredicate([PlayerPawn](const FAIPlayerInfo& Info) { return Info.Pawn.Get() == PlayerPawn; });
+		Player.LockOn = Previous ? Previous->LockOn : PlayerPawn->FindComponentByClass<UCameraLockOnComponent>();
+
+		if (const UCameraLockOnComponent* LockOn = Player.LockOn.Get(); LockOn && LockOn->IsLockedOn())
+		{
+			Player.LockOnTarget = LockOn->GetLockedOnTarget();
+		}
+	}
+}
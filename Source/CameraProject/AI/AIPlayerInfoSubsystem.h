@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIPlayerInfoSubsystem.generated.h"
+
+class APawn;
+class UCameraLockOnComponent;
+
+/**
+ *  Cached state of one player, shared by all AI queries in a frame
+ */
+struct FAIPlayerInfo
+{
+	/** Pawn possessed by the player */
+	TWeakObjectPtr<APawn> Pawn;
+
+	/** Lock-on component on the pawn, if it has one */
+	TWeakObjectPtr<UCameraLockOnComponent> LockOn;
+
+	/** Pawn location */
+	FVector Location = FVector::ZeroVector;
+
+	/** Pawn velocity */
+	FVector Velocity = FVector::ZeroVector;
+
+	/** Actor the player is locked on to, if any */
+	TWeakObjectPtr<AActor> LockOnTarget;
+};
+
+/**
+ *  World subsystem that gathers every player's pawn, location, velocity and lock-on state once per frame.
+ *  StateTree tasks and EQS contexts read players from here instead of each looking up player 0 on their own.
+ *  The cache is refreshed on the first read of a frame, so it's never stale and costs nothing on frames nobody asks.
+ */
+UCLASS()
+class UAIPlayerInfoSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Players with a pawn, as of LastRefreshFrame */
+	TArray<FAIPlayerInfo> Players;
+
+	/** Frame the cache was last refreshed on */
+	uint64 LastRefreshFrame = TNumericLimits<uint64>::Max();
+
+public:
+
+	/** Returns every player with a pawn */
+	TConstArrayView<FAIPlayerInfo> GetPlayers();
+
+	/** Returns the player closest to the location, or nullptr if there isn't any. Optionally returns the distance to it */
+	const FAIPlayerInfo* FindClosestPlayer(const FVector& Location, double* OutDistance = nullptr);
+
+protected:
+
+	/** Rebuilds the cache if it's from an earlier frame */
+	void RefreshIfStale();
+};
@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AITickLODSubsystem.h"
+#include "BrainComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "AIPlayerInfoSubsystem.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Tick LOD"), STAT_AITickLOD, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI Tier: Every Frame"), STAT_AITierNear, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI Tier: Mid Rate"), STAT_AITierMid, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI Tier: Far Rate"), STAT_AITierFar, STATGROUP_CameraProject);
+
+void UAITickLODSubsystem::RegisterAgent(UBrainComponent* Brain)
+{
+	if (!Brain || Agents.ContainsByPredicate([Brain](const FAgent& Agent) { return Agent.Brain.Get() == Brain; }))
+	{
+		return;
+	}
+
+	// new agents tick every frame until their first evaluation
+	FAgent& Agent = Agents.AddDefaulted_GetRef();
+	Agent.Brain = Brain;
+}
+
+void UAITickLODSubsystem::UnregisterAgent(UBrainComponent* Brain)
+{
+	const int32 NumRemoved = Agents.RemoveAll([Brain](const FAgent& Agent) { return Agent.Brain.Get() == Brain; });
+
+	if (NumRemoved > 0 && Brain)
+	{
+		Brain->SetComponentTickInterval(0.0f);
+	}
+}
+
+void UAITickLODSubsystem::WakeAgent(UBrainComponent* Brain)
+{
+	for (FAgent& Agent : Agents)
+	{
+		if (Agent.Brain.Get() == Brain)
+		{
+			SetTickInterval(Agent, 0.0f);
+			return;
+		}
+	}
+}
+
+float UAITickLODSubsystem::GetTickIntervalForDistance(const double Distance) const
+{
+	if (Distance < NearDistance)
+	{
+		return 0.0f;
+	}
+
+	const float TickRate = Distance < MidDistance ? MidTickRate : FarTickRate;
+
+	return TickRate > 0.0f ? 1.0f / TickRate : 0.0f;
+}
+
+int32 UAITickLODSubsystem::GetNumToEvaluate(const int32 NumAgents, const float DeltaTime) const
+{
+	if (NumAgents <= 0)
+	{
+		return 0;
+	}
+
+	if (ReevaluationPeriod <= DeltaTime)
+	{
+		return NumAgents;
+	}
+
+	return FMath::Clamp(FMath::CeilToInt32(NumAgents * DeltaTime / ReevaluationPeriod), 1, NumAgents);
+}
+
+bool UAITickLODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAITickLODSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AITickLOD);
+
+	// drop destroyed agents
+	Agents.RemoveAll([](const FAgent& Agent) { return !Agent.Brain.IsValid(); });
+
+	if (Agents.IsEmpty())
+	{
+		return;
+	}
+
+	UAIPlayerInfoSubsystem* PlayerInfo = GetWorld()->GetSubsystem<UAIPlayerInfoSubsystem>();
+
+	// re-evaluate this frame's slice, picking up where the last frame left off
+	const int32 NumToEvaluate = GetNumToEvaluate(Agents.Num(), DeltaTime);
+
+	for (int32 i = 0; i < NumToEvaluate; ++i)
+	{
+		EvaluationCursor = EvaluationCursor % Agents.Num();
+		FAgent& Agent = Agents[EvaluationCursor++];
+
+		const AController* Controller = Cast<AController>(Agent.Brain->GetOwner());
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+
+		double Distance = 0.0;
+
+		// without a pawn or a player there's nothing to measure against
+		if (!Pawn || !PlayerInfo || !PlayerInfo->FindClosestPlayer(Pawn->GetActorLocation(), &Distance))
+		{
+			SetTickInterval(Agent, 0.0f);
+			continue;
+		}
+
+		SetTickInterval(Agent, GetTickIntervalForDistance(Distance));
+	}
+
+	// count the tiers
+	const float MidInterval = MidTickRate > 0.0f ? 1.0f / MidTickRate : 0.0f;
+	int32 NumNear = 0;
+	int32 NumMid = 0;
+	int32 NumFar = 0;
+
+	for (const FAgent& Agent : Agents)
+	{
+		if (Agent.TickInterval <= 0.0f)
+		{
+			++NumNear;
+
+		} else if (Agent.TickInterval == MidInterval) {
+
+			++NumMid;
+
+		} else {
+
+			++NumFar;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AITierNear, NumNear);
+	SET_DWORD_STAT(STAT_AITierMid, NumMid);
+	SET_DWORD_STAT(STAT_AITierFar, NumFar);
+}
+
+TStatId UAITickLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAITickLODSubsystem, STATGROUP_Tickables);
+}
+
+void UAITickLODSubsystem::SetTickInterval(FAgent& Agent, const float TickInterval)
+{
+	if (Agent.TickInterval == TickInterval)
+	{
+		return;
+	}
+
+	Agent.TickInterval = TickInterval;
+
+	// the tick function accumulates the skipped time, so the brain still sees the full elapsed time
+	if (UBrainComponent* Brain = Agent.Brain.Get())
+	{
+		Brain->SetComponentTickInterval(TickInterval);
+	}
+}
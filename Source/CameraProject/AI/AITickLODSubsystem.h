@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AITickLODSubsystem.generated.h"
+
+class UBrainComponent;
+
+/**
+ *  World subsystem that ticks AI logic on a schedule driven by distance to the closest player.
+ *  Registered brain components tick every frame near a player, at MidTickRate in mid range and at FarTickRate beyond.
+ *  Throttled brains receive the accumulated delta time, so time based StateTree tasks behave the same at any rate.
+ *  Agents are re-evaluated round-robin, a slice per frame, so tier changes and the tick phases that follow them
+ *  are spread over frames instead of bunching up. Without any player pawn, every agent ticks every frame.
+ */
+UCLASS(Config=Game)
+class UAITickLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Agents closer than this to a player tick every frame */
+	UPROPERTY(Config)
+	float NearDistance = 1500.0f;
+
+	/** Agents closer than this to a player tick at MidTickRate. Agents further away tick at FarTickRate */
+	UPROPERTY(Config)
+	float MidDistance = 4000.0f;
+
+	/** Tick rate in mid range, in Hz. Zero or less ticks every frame */
+	UPROPERTY(Config)
+	float MidTickRate = 5.0f;
+
+	/** Tick rate beyond mid range, in Hz. Zero or less ticks every frame */
+	UPROPERTY(Config)
+	float FarTickRate = 1.0f;
+
+	/** Time over which every agent is re-evaluated once */
+	UPROPERTY(Config)
+	float ReevaluationPeriod = 0.5f;
+
+	/** A registered agent */
+	struct FAgent
+	{
+		TWeakObjectPtr<UBrainComponent> Brain;
+		float TickInterval = 0.0f;
+	};
+
+	/** Registered agents */
+	TArray<FAgent> Agents;
+
+	/** Index of the next agent to re-evaluate */
+	int32 EvaluationCursor = 0;
+
+public:
+
+	/** Starts scheduling the brain's tick */
+	void RegisterAgent(UBrainComponent* Brain);
+
+	/** Stops scheduling the brain's tick and puts it back to every frame */
+	void UnregisterAgent(UBrainComponent* Brain);
+
+	/** Makes the brain tick every frame until it's next re-evaluated. Use when something needs a quick reaction */
+	void WakeAgent(UBrainComponent* Brain);
+
+	/** Returns the tick interval for an agent at the given distance from the closest player. Zero ticks every frame */
+	float GetTickIntervalForDistance(double Distance) const;
+
+	/** Returns how many agents should be re-evaluated this frame to cover them all once per re-evaluation period */
+	int32 GetNumToEvaluate(int32 NumAgents, float DeltaTime) const;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Re-evaluates this frame's slice of agents */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Sets the agent's tick interval if it changed */
+	static void SetTickInterval(FAgent& Agent, float TickInterval);
+};
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CameraOcclusionFadeSubsystem.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "CameraLockOnComponent.h"
+#include "ILockOnTarget.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Occlusion Fade"), STAT_CameraOcclusionFade, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Camera Faded Primitives"), STAT_CameraFadedPrimitives, STATGROUP_CameraProject);
+
+void UCameraOcclusionFadeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadedParameterCollection = FadeParameterCollection.LoadSynchronous();
+}
+
+bool UCameraOcclusionFadeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCameraOcclusionFadeSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CameraOcclusionFade);
+
+	ReadBackTraces();
+	UpdateFades(DeltaTime);
+	QueueTraces();
+
+	SET_DWORD_STAT(STAT_CameraFadedPrimitives, FadingPrimitives.Num());
+}
+
+TStatId UCameraOcclusionFadeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCameraOcclusionFadeSubsystem, STATGROUP_Tickables);
+}
+
+void UCameraOcclusionFadeSubsystem::ReadBackTraces()
+{
+	UWorld* World = GetWorld();
+
+	// everything is clear until a trace says otherwise
+	for (TPair<TWeakObjectPtr<UPrimitiveComponent>, FFadeState>& Pair : FadingPrimitives)
+	{
+		Pair.Value.bOccluding = false;
+	}
+
+	FTraceDatum Datum;
+
+	for (const FTraceHandle& Handle : PendingTraces)
+	{
+		if (!World->QueryTraceData(Handle, Datum))
+		{
+			continue;
+		}
+
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (UPrimitiveComponent* Primitive = Hit.GetComponent())
+			{
+				FadingPrimitives.FindOrAdd(Primitive).bOccluding = true;
+			}
+		}
+	}
+
+	PendingTraces.Reset();
+}
+
+void UCameraOcclusionFadeSubsystem::QueueTraces()
+{
+	UWorld* World = GetWorld();
+
+	// object queries return every primitive along the ray, not just the first blocking one
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	bool bFocusSet = false;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+
+		if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+		{
+			continue;
+		}
+
+		APawn* Pawn = PlayerController->GetPawn();
+
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CameraOcclusionFade), false, Pawn);
+
+		// trace to the pawn
+		PendingTraces.Add(World->AsyncLineTraceByObjectType(EAsyncTraceType::Multi, CameraLocation, Pawn->GetActorLocation(), ObjectParams, QueryParams));
+
+		// and to the lock-on target, if we have one
+		if (const UCameraLockOnComponent* LockOn = Pawn->FindComponentByClass<UCameraLockOnComponent>())
+		{
+			AActor* Target = LockOn->GetLockedOnTarget();
+
+			if (const ILockOnTarget* LockOnTarget = Cast<ILockOnTarget>(Target))
+			{
+				QueryParams.AddIgnoredActor(Target);
+				PendingTraces.Add(World->AsyncLineTraceByObjectType(EAsyncTraceType::Multi, CameraLocation, LockOnTarget->GetLockOnLocation(), ObjectParams, QueryParams));
+			}
+		}
+
+		// let materials know what we're focusing on
+		if (!bFocusSet && LoadedParameterCollection)
+		{
+			if (UMaterialParameterCollectionInstance* Collection = World->GetParameterCollectionInstance(LoadedParameterCollection))
+			{
+				Collection->SetVectorParameterValue(FocusLocationParameter, Pawn->GetActorLocation());
+			}
+
+			bFocusSet = true;
+		}
+	}
+}
+
+void UCameraOcclusionFadeSubsystem::UpdateFades(const float DeltaTime)
+{
+	for (auto It = FadingPrimitives.CreateIterator(); It; ++It)
+	{
+		UPrimitiveComponent* Primitive = It.Key().Get();
+
+		if (!Primitive)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FFadeState& State = It.Value();
+
+		const float TargetOpacity = State.bOccluding ? OccludedOpacity : 1.0f;
+		const float NewOpacity = FMath::FInterpConstantTo(State.Opacity, TargetOpacity, DeltaTime, FadeSpeed);
+
+		if (NewOpacity != State.Opacity)
+		{
+			State.Opacity = NewOpacity;
+			Primitive->SetCustomPrimitiveDataFloat(FadeCustomDataIndex, NewOpacity);
+		}
+
+		// fully faded back in, stop tracking it
+		if (!State.bOccluding && State.Opacity >= 1.0f)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
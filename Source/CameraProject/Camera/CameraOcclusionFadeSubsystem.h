@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "CameraOcclusionFadeSubsystem.generated.h"
+
+class UMaterialParameterCollection;
+class UPrimitiveComponent;
+
+/**
+ *  World subsystem that fades out geometry between the camera and what it's looking at.
+ *  Once per frame it queues one batch of async multi-hit traces from every local player's camera to its pawn and lock-on target,
+ *  and fades the primitives those traces went through. The fade amount goes to each primitive's custom primitive data,
+ *  for a dithered opacity mask in its material. Fade state lives here, so faded actors don't need to tick.
+ */
+UCLASS(Config=Game)
+class UCameraOcclusionFadeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Material parameter collection updated with the view data fading materials may need */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UMaterialParameterCollection> FadeParameterCollection;
+
+	/** Vector parameter in the collection set to the first local player's focus location */
+	UPROPERTY(Config)
+	FName FocusLocationParameter = TEXT("OcclusionFocusLocation");
+
+	/** Custom primitive data index the fade opacity is written to */
+	UPROPERTY(Config)
+	int32 FadeCustomDataIndex = 0;
+
+	/** Opacity occluding primitives fade down to */
+	UPROPERTY(Config)
+	float OccludedOpacity = 0.25f;
+
+	/** Opacity change per second */
+	UPROPERTY(Config)
+	float FadeSpeed = 4.0f;
+
+	/** Fade state of a primitive */
+	struct FFadeState
+	{
+		float Opacity = 1.0f;
+		bool bOccluding = false;
+	};
+
+	/** Primitives being faded, in or out */
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, FFadeState> FadingPrimitives;
+
+	/** Traces queued last frame, read back this frame */
+	TArray<FTraceHandle> PendingTraces;
+
+	/** Loaded parameter collection */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialParameterCollection> LoadedParameterCollection;
+
+public:
+
+	/** Subsystem initialization */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Reads back last frame's traces, updates the fades and queues the next traces */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Marks the primitives hit by last frame's traces as occluding */
+	void ReadBackTraces();
+
+	/** Queues this frame's traces for every local player */
+	void QueueTraces();
+
+	/** Moves every tracked primitive's opacity towards its target and drops the ones that are fully back */
+	void UpdateFades(float DeltaTime);
+};
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CameraProbeSpringArmComponent.h"
+#include "CameraProbeSubsystem.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+
+void UCameraProbeSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	UCameraProbeSubsystem* ProbeSubsystem = World ? World->GetSubsystem<UCameraProbeSubsystem>() : nullptr;
+
+	// sync probes and editor previews run the stock sweep
+	if (!bDoTrace || ProbeMode == ECameraProbeMode::Sync || !ProbeSubsystem || !World->IsGameWorld())
+	{
+		if (bDoTrace && ProbeSubsystem)
+		{
+			ProbeSubsystem->RecordSyncProbe();
+		}
+
+		Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+		return;
+	}
+
+	// run the arm update without a sweep. This leaves the lagged origin and the unobstructed camera location behind
+	Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+
+	const FVector ArmOrigin = PreviousArmOrigin;
+	const FVector DesiredLocation = UnfixedCameraPosition;
+
+	// queue this frame's probe and read back last frame's
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CameraProbe), false, GetOwner());
+
+	float TargetFraction = ProbeFraction;
+	ProbeSubsystem->ProbeAsync(this, ArmOrigin, DesiredLocation, FCollisionShape::MakeSphere(ProbeSize), ProbeChannel, QueryParams, TargetFraction);
+
+	// pull in right away so we don't clip, ease back out
+	if (TargetFraction < ProbeFraction)
+	{
+		ProbeFraction = TargetFraction;
+
+	} else {
+
+		ProbeFraction = FMath::FInterpTo(ProbeFraction, TargetFraction, DeltaTime, ProbeReleaseSpeed);
+	}
+
+	bIsCameraFixed = ProbeFraction < 1.0f;
+
+	if (!bIsCameraFixed)
+	{
+		return;
+	}
+
+	// move the socket along the arm and refresh the camera
+	const FTransform ComponentTransform = GetComponentTransform();
+	const FQuat CameraRotation = ComponentTransform.TransformRotation(RelativeSocketRotation);
+	const FVector ResultLocation = FMath::Lerp(ArmOrigin, DesiredLocation, ProbeFraction);
+
+	const FTransform RelativeCameraTransform = FTransform(CameraRotation, ResultLocation).GetRelativeTransform(ComponentTransform);
+	RelativeSocketLocation = RelativeCameraTransform.GetLocation();
+	RelativeSocketRotation = RelativeCameraTransform.GetRotation();
+
+	UpdateChildTransforms();
+}
+
+void UCameraProbeSpringArmComponent::OnUnregister()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UCameraProbeSubsystem* ProbeSubsystem = World->GetSubsystem<UCameraProbeSubsystem>())
+		{
+			ProbeSubsystem->ReleaseProbe(this);
+		}
+	}
+
+	Super::OnUnregister();
+}
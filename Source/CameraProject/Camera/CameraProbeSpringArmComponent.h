@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "CameraProbeSpringArmComponent.generated.h"
+
+/** How a spring arm runs its camera collision probe */
+UENUM(BlueprintType)
+enum class ECameraProbeMode : uint8
+{
+	/** Sweep on the game thread every frame, like the stock spring arm */
+	Sync,
+
+	/** Queue an async sweep through the camera probe subsystem and apply its result next frame */
+	Async
+};
+
+/**
+ *  Spring arm whose collision probe can run asynchronously through UCameraProbeSubsystem.
+ *  Async probes are applied with one frame of latency: the arm pulls in immediately to the probed length and eases back out.
+ */
+UCLASS(ClassGroup=Camera, meta=(BlueprintSpawnableComponent))
+class UCameraProbeSpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** How this arm runs its collision probe */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Camera Collision", meta=(EditCondition="bDoCollisionTest"))
+	ECameraProbeMode ProbeMode = ECameraProbeMode::Async;
+
+	/** Speed the arm eases back out at once an async probe stops hitting */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Camera Collision", meta=(EditCondition="bDoCollisionTest", ClampMin=0, ClampMax=100))
+	float ProbeReleaseSpeed = 10.0f;
+
+protected:
+
+	/** Smoothed fraction of the arm length left by the async probe */
+	float ProbeFraction = 1.0f;
+
+	/** Runs the stock arm update, swapping the synchronous sweep for an async one if needed */
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+	/** Releases the pending async probe */
+	virtual void OnUnregister() override;
+};
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CameraProbeSubsystem.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+#include "CollisionQueryParams.h"
+#include "CameraProject.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Probes (Async)"), STAT_CameraProbesAsync, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Probes (Sync)"), STAT_CameraProbesSync, STATGROUP_CameraProject);
+
+bool UCameraProbeSubsystem::ProbeAsync(const UObject* Owner, const FVector& Start, const FVector& End, const FCollisionShape& Shape,
+	ECollisionChannel Channel, const FCollisionQueryParams& Params, float& OutFraction)
+{
+	UWorld* World = GetWorld();
+	FTraceHandle& Handle = PendingProbes.FindOrAdd(FObjectKey(Owner));
+
+	// read back last frame's probe
+	bool bHasResult = false;
+	FTraceDatum Datum;
+
+	if (Handle.IsValid() && World->QueryTraceData(Handle, Datum))
+	{
+		bHasResult = true;
+		OutFraction = 1.0f;
+
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				OutFraction = Hit.Time;
+				break;
+			}
+		}
+	}
+
+	// queue this frame's probe. It runs with every other async trace at the end of the frame
+	Handle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, Channel, Shape, Params);
+
+	INC_DWORD_STAT(STAT_CameraProbesAsync);
+
+	return bHasResult;
+}
+
+void UCameraProbeSubsystem::RecordSyncProbe()
+{
+	INC_DWORD_STAT(STAT_CameraProbesSync);
+}
+
+void UCameraProbeSubsystem::ReleaseProbe(const UObject* Owner)
+{
+	PendingProbes.Remove(FObjectKey(Owner));
+}
@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "CollisionShape.h"
+#include "UObject/ObjectKey.h"
+#include "CameraProbeSubsystem.generated.h"
+
+struct FCollisionQueryParams;
+
+/**
+ *  World subsystem that runs spring arm camera collision probes as async sweeps.
+ *  Probes queued during a frame are batched by the async trace system and run in parallel at the end of the frame.
+ *  Their results are read back by the same arm on the next frame.
+ */
+UCLASS()
+class UCameraProbeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 *  Queues an async probe for the owner and reads back the one it queued last frame.
+	 *  Returns true and the blocking hit fraction along the probe (1 if nothing was hit) if last frame's result was available.
+	 */
+	bool ProbeAsync(const UObject* Owner, const FVector& Start, const FVector& End, const FCollisionShape& Shape,
+		ECollisionChannel Channel, const FCollisionQueryParams& Params, float& OutFraction);
+
+	/** Counts a probe the owner ran synchronously, for stats */
+	void RecordSyncProbe();
+
+	/** Forgets the owner's pending probe */
+	void ReleaseProbe(const UObject* Owner);
+
+protected:
+
+	/** Async trace handle queued by each owner last frame */
+	TMap<FObjectKey, FTraceHandle> PendingProbes;
+};
@@ -21,10 +21,21 @@ public class CameraProject : ModuleRules
 			"Slate"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "SlateCore", "PhysicsCore" });
+
+		// networked automation tests start play sessions through the editor
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+
+		// Gameplay Debugger categories are compiled out of Shipping and Test builds
+		SetupGameplayDebuggerSupport(Target);
 
 		PublicIncludePaths.AddRange(new string[] {
 			"CameraProject",
+			"CameraProject/AI",
+			"CameraProject/Camera",
 			"CameraProject/LockOn",
 			"CameraProject/Tests",
 			"CameraProject/Variant_Platforming",
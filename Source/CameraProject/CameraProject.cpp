@@ -3,6 +3,41 @@
 #include "CameraProject.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, CameraProject, "CameraProject" );
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "GameplayDebuggerCategory_LockOn.h"
+#endif
+
+/**
+ *  Game module for CameraProject
+ *  Registers the project's debugging tools
+ */
+class FCameraProjectModule : public FDefaultGameModuleImpl
+{
+public:
+
+	virtual void StartupModule() override
+	{
+#if WITH_GAMEPLAY_DEBUGGER
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.RegisterCategory("LockOn", IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_LockOn::MakeInstance), EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
+	}
+
+	virtual void ShutdownModule() override
+	{
+#if WITH_GAMEPLAY_DEBUGGER
+		if (IGameplayDebugger::IsAvailable())
+		{
+			IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+			GameplayDebuggerModule.UnregisterCategory("LockOn");
+			GameplayDebuggerModule.NotifyCategoriesChanged();
+		}
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FCameraProjectModule, CameraProject, "CameraProject" );
 
 DEFINE_LOG_CATEGORY(LogCameraProject)
\ No newline at end of file
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogCameraProject, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogCameraProject, Log, All);
+
+/** Stat group for the project's gameplay systems. Use "stat CameraProject" to display it */
+DECLARE_STATS_GROUP(TEXT("CameraProject"), STATGROUP_CameraProject, STATCAT_Advanced);
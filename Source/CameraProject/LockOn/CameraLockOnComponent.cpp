@@ -9,14 +9,63 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "CameraProjectCharacter.h"
 #include "ILockOnTarget.h"
+#include "CameraProject.h"
+#include "LockOnTargetRegistry.h"
+#include "Net/UnrealNetwork.h"
+#include "SLockOnReticle.h"
+#include "SceneView.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
 
 class ILockOnTarget;
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock-On LOS Traces"), STAT_LockOnLineOfSightTraces, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock-On LOS Targets"), STAT_LockOnLineOfSightTargets, STATGROUP_CameraProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Lock-On Avg Traces Per Target"), STAT_LockOnAverageTracesPerTarget, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock-On Replicated Bits"), STAT_LockOnReplicatedBits, STATGROUP_CameraProject);
+
+bool FLockOnReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// lock flag
+	uint8 bLockedOnBit = bLockedOn ? 1 : 0;
+	Ar.SerializeBits(&bLockedOnBit, 1);
+	bLockedOn = bLockedOnBit != 0;
+
+	// quantized target handle, only sent while locked on
+	uint32 Handle = bLockedOn ? TargetHandle : 0;
+	if (bLockedOn)
+	{
+		Ar.SerializeInt(Handle, LockOnTargetHandleMax);
+	}
+	TargetHandle = static_cast<uint16>(Handle);
+
+	// switch sequence counter
+	Ar << SwitchSequence;
+
+	if (Ar.IsSaving())
+	{
+		INC_DWORD_STAT_BY(STAT_LockOnReplicatedBits, 1 + (bLockedOn ? LockOnTargetHandleBits : 0) + 8);
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
 UCameraLockOnComponent::UCameraLockOnComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	// lock-on state is server-authoritative and mirrored to all clients
+	SetIsReplicatedByDefault(true);
+}
+
+void UCameraLockOnComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UCameraLockOnComponent, ReplicatedState);
 }
 
 void UCameraLockOnComponent::BeginPlay()
@@ -41,6 +90,40 @@ void UCameraLockOnComponent::TickComponent(const float DeltaTime, const ELevelTi
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// Only the controlling player drives lock-on; everyone else mirrors the replicated state
+	if (!IsLocallyControlled())
+	{
+		// The server still drops remote players' locks on targets that died or went away
+		if (GetOwnerRole() == ROLE_Authority)
+		{
+			ServerValidateLockOn();
+		}
+		return;
+	}
+
+	UpdateLockOn(DeltaTime);
+
+	// Refresh the reticle after the target may have changed
+	UpdateReticle(DeltaTime);
+}
+
+void UCameraLockOnComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// Remove the reticle overlay from the viewport
+	if (ReticleWidget.IsValid())
+	{
+		if (ULocalPlayer* LocalPlayer = ReticlePlayer.Get(); LocalPlayer && LocalPlayer->ViewportClient)
+		{
+			LocalPlayer->ViewportClient->RemoveViewportWidgetForPlayer(LocalPlayer, ReticleWidget.ToSharedRef());
+		}
+		ReticleWidget.Reset();
+	}
+}
+
+void UCameraLockOnComponent::UpdateLockOn(const float DeltaTime)
+{
 	if (!bIsLockedOn || !CameraComponent || !OwnerCharacter)
 	{
 		return;
@@ -50,6 +133,7 @@ void UCameraLockOnComponent::TickComponent(const float DeltaTime, const ELevelTi
 	if (!LockedOnTarget.IsValid())
 	{
 		bIsLockedOn = false;
+		CommitLockOnState();
 		return;
 	}
 
@@ -68,12 +152,15 @@ void UCameraLockOnComponent::TickComponent(const float DeltaTime, const ELevelTi
 				if (!LockedOnTarget.IsValid())
 				{
 					bIsLockedOn = false;
+					CommitLockOnState();
 					return;
 				}
+				CommitLockOnState();
 			}
 			else
 			{
 				bIsLockedOn = false;
+				CommitLockOnState();
 				return;
 			}
 		}
@@ -110,6 +197,8 @@ void UCameraLockOnComponent::SetLockOnEnabled(const bool bEnabled)
 		bIsLockedOn = false;
 		LockedOnTarget.Reset();
 	}
+
+	CommitLockOnState();
 }
 
 void UCameraLockOnComponent::ToggleLockOn()
@@ -127,6 +216,7 @@ void UCameraLockOnComponent::SwitchTargetLeft()
 	if (AActor* NextTarget = FindNextTargetInDirection(true))
 	{
 		LockedOnTarget = NextTarget;
+		CommitLockOnState();
 	}
 }
 
@@ -140,6 +230,7 @@ void UCameraLockOnComponent::SwitchTargetRight()
 	if (AActor* NextTarget = FindNextTargetInDirection(false))
 	{
 		LockedOnTarget = NextTarget;
+		CommitLockOnState();
 	}
 }
 
@@ -158,6 +249,36 @@ TArray<AActor*> UCameraLockOnComponent::FindTargetsInView() const
 	const float CurrentFOV = CameraComponent->FieldOfView;
 	const float FOVToUse = DetectionFOV > 0.0f ? DetectionFOV : CurrentFOV;
 
+	// Forget the last known visibility of destroyed targets
+	for (auto It = LastKnownVisibility.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+#if WITH_GAMEPLAY_DEBUGGER
+	// Only pay for debug bookkeeping while the gameplay debugger category is watching
+	const bool bRecordDebug = GFrameCounter <= DebugRecordUntilFrame;
+	const ULockOnTargetRegistry* Registry = GetTargetRegistry();
+	uint64 PhaseStartCycles = bRecordDebug ? FPlatformTime::Cycles64() : 0;
+	if (bRecordDebug)
+	{
+		LastDebugQuery = FLockOnDebugQuery();
+		LastDebugQuery.Frame = GFrameCounter;
+	}
+
+	// Returns the elapsed microseconds since the last phase mark and starts a new phase
+	auto MarkDebugPhase = [&PhaseStartCycles]()
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		const double Microseconds = FPlatformTime::ToMilliseconds64(Now - PhaseStartCycles) * 1000.0;
+		PhaseStartCycles = Now;
+		return Microseconds;
+	};
+#endif
+
 	// Find all actors within search radius
 	TArray<AActor*> OverlappingActors;
 	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
@@ -176,7 +297,15 @@ TArray<AActor*> UCameraLockOnComponent::FindTargetsInView() const
 		OverlappingActors
 	);
 
-	// Filter to only valid lock-on targets that are in view
+#if WITH_GAMEPLAY_DEBUGGER
+	if (bRecordDebug)
+	{
+		LastDebugQuery.OverlapMicroseconds = MarkDebugPhase();
+	}
+#endif
+
+	// Filter to only valid lock-on targets that are in view, leaving the line of sight test for last
+	TArray<TPair<float, AActor*>> ScoredCandidates;
 	for (AActor* Actor : OverlappingActors)
 	{
 		if (const ILockOnTarget* LockOnTarget = Cast<ILockOnTarget>(Actor))
@@ -192,12 +321,6 @@ TArray<AActor*> UCameraLockOnComponent::FindTargetsInView() const
 				continue;
 			}
 
-			// Check line of sight
-			if (!HasLineOfSight(Actor, CameraLocation))
-			{
-				continue;
-			}
-
 			// Check distance
 			const FVector TargetLocation = LockOnTarget->GetLockOnLocation();
 			const float Distance = FVector::Dist(CameraLocation, TargetLocation);
@@ -206,10 +329,58 @@ TArray<AActor*> UCameraLockOnComponent::FindTargetsInView() const
 				continue;
 			}
 
-			ValidTargets.Add(Actor);
+			ScoredCandidates.Emplace(CalculateTargetScore(Actor, CameraLocation, CameraForward), Actor);
+		}
+	}
+
+	// Spend the trace budget on the best candidates first
+	ScoredCandidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+#if WITH_GAMEPLAY_DEBUGGER
+	if (bRecordDebug)
+	{
+		LastDebugQuery.FilterMicroseconds = MarkDebugPhase();
+	}
+#endif
+
+	for (const TPair<float, AActor*>& Candidate : ScoredCandidates)
+	{
+#if WITH_GAMEPLAY_DEBUGGER
+		const int32 TracesBefore = Registry ? Registry->GetLineOfSightTracesThisFrame() : 0;
+#endif
+
+		// Check line of sight
+		const bool bVisible = HasLineOfSight(Candidate.Value, CameraLocation);
+		if (bVisible)
+		{
+			ValidTargets.Add(Candidate.Value);
+		}
+
+#if WITH_GAMEPLAY_DEBUGGER
+		if (bRecordDebug)
+		{
+			FLockOnDebugCandidate& DebugCandidate = LastDebugQuery.Candidates.AddDefaulted_GetRef();
+			DebugCandidate.Actor = Candidate.Value;
+			DebugCandidate.Location = Cast<ILockOnTarget>(Candidate.Value)->GetLockOnLocation();
+			DebugCandidate.Score = CalculateTargetScoreBreakdown(Candidate.Value, CameraLocation, CameraForward,
+				DebugCandidate.AngleScore, DebugCandidate.DistanceScore, DebugCandidate.PriorityScore);
+			DebugCandidate.Traces = Registry ? Registry->GetLineOfSightTracesThisFrame() - TracesBefore : 0;
+			DebugCandidate.bVisible = bVisible;
+			DebugCandidate.bOverBudget = Registry && Registry->GetLineOfSightTracesThisFrame() >= Registry->GetMaxLineOfSightTracesPerFrame();
 		}
+#endif
 	}
 
+#if WITH_GAMEPLAY_DEBUGGER
+	if (bRecordDebug)
+	{
+		LastDebugQuery.LineOfSightMicroseconds = MarkDebugPhase();
+	}
+#endif
+
 	return ValidTargets;
 }
 
@@ -253,28 +424,103 @@ bool UCameraLockOnComponent::HasLineOfSight(AActor* Target, const FVector& Camer
 		return false;
 	}
 
-	const FVector TargetLocation = LockOnTarget->GetLockOnLocation();
-	const FVector Direction = (TargetLocation - CameraLocation);
-	const float Distance = Direction.Size();
-	const FVector DirectionNormal = Direction.GetSafeNormal();
+	// Gather the lock-on points in preference order
+	TArray<FVector> TargetLocations;
+	LockOnTarget->GetLockOnLocations(TargetLocations);
 
-	// Perform line trace to check for obstructions
-	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(OwnerCharacter);
 	QueryParams.AddIgnoredActor(Target);
 	QueryParams.bTraceComplex = false;
 
-	const bool bHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
-		CameraLocation,
-		CameraLocation + (DirectionNormal * Distance),
-		ECC_Visibility,
-		QueryParams
-	);
+	++TotalLineOfSightTargets;
+	INC_DWORD_STAT(STAT_LockOnLineOfSightTargets);
+
+	ULockOnTargetRegistry* Registry = GetTargetRegistry();
+	int32 NumTraces = 0;
+
+	const ELockOnVisibility Visibility = EvaluateLockOnPoints(TargetLocations,
+		// Charge every trace against the world's budget, shared with the other lock-on components
+		[Registry]() { return !Registry || Registry->ConsumeLineOfSightTrace(); },
+		// Perform line trace to check for obstructions
+		[this, &CameraLocation, &QueryParams](const FVector& TargetLocation)
+		{
+			FHitResult HitResult;
+			return !GetWorld()->LineTraceSingleByChannel(HitResult, CameraLocation, TargetLocation, ECC_Visibility, QueryParams);
+		},
+		nullptr, &NumTraces);
+
+	TotalLineOfSightTraces += NumTraces;
+	INC_DWORD_STAT_BY(STAT_LockOnLineOfSightTraces, NumTraces);
+	SET_FLOAT_STAT(STAT_LockOnAverageTracesPerTarget, GetAverageTracesPerTarget());
+
+	// Out of budget: keep the last conclusive result so visible targets aren't dropped just because traces ran out
+	if (Visibility == ELockOnVisibility::OutOfBudget)
+	{
+		const bool* LastVisible = LastKnownVisibility.Find(Target);
+		return LastVisible && *LastVisible;
+	}
+
+	const bool bVisible = Visibility == ELockOnVisibility::Visible;
+	LastKnownVisibility.Add(Target, bVisible);
+
+	return bVisible;
+}
+
+ELockOnVisibility UCameraLockOnComponent::EvaluateLockOnPoints(TConstArrayView<FVector> Points, TFunctionRef<bool()> ConsumeTrace,
+                                                               TFunctionRef<bool(const FVector&)> IsPointVisible, int32* OutVisibleIndex, int32* OutNumTraces)
+{
+	int32 NumTraces = 0;
+	ELockOnVisibility Visibility = ELockOnVisibility::Hidden;
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		// Stop testing once the budget is spent
+		if (!ConsumeTrace())
+		{
+			Visibility = ELockOnVisibility::OutOfBudget;
+			break;
+		}
+
+		++NumTraces;
+
+		// The first unobstructed point is enough
+		if (IsPointVisible(Points[Index]))
+		{
+			Visibility = ELockOnVisibility::Visible;
+
+			if (OutVisibleIndex)
+			{
+				*OutVisibleIndex = Index;
+			}
+			break;
+		}
+	}
+
+	if (OutNumTraces)
+	{
+		*OutNumTraces = NumTraces;
+	}
+
+	return Visibility;
+}
+
+ULockOnTargetRegistry* UCameraLockOnComponent::GetTargetRegistry() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<ULockOnTargetRegistry>() : nullptr;
+}
+
+#if WITH_GAMEPLAY_DEBUGGER
+void UCameraLockOnComponent::RequestDebugRecording(const uint64 NumFrames) const
+{
+	DebugRecordUntilFrame = GFrameCounter + NumFrames;
+}
+#endif
 
-	// If we hit something, there's no clear line of sight
-	return !bHit;
+float UCameraLockOnComponent::GetAverageTracesPerTarget() const
+{
+	return TotalLineOfSightTargets > 0 ? static_cast<float>(static_cast<double>(TotalLineOfSightTraces) / static_cast<double>(TotalLineOfSightTargets)) : 0.0f;
 }
 
 AActor* UCameraLockOnComponent::SelectBestTarget(const TArray<AActor*>& Candidates, const FVector& CameraLocation,
@@ -309,6 +555,16 @@ AActor* UCameraLockOnComponent::SelectBestTarget(const TArray<AActor*>& Candidat
 float UCameraLockOnComponent::CalculateTargetScore(AActor* Target, const FVector& CameraLocation,
                                                    const FVector& CameraForward)
 {
+	float AngleScore, DistanceScore, PriorityScore;
+	return CalculateTargetScoreBreakdown(Target, CameraLocation, CameraForward, AngleScore, DistanceScore, PriorityScore);
+}
+
+float UCameraLockOnComponent::CalculateTargetScoreBreakdown(AActor* Target, const FVector& CameraLocation,
+                                                            const FVector& CameraForward, float& OutAngleScore,
+                                                            float& OutDistanceScore, float& OutPriorityScore)
+{
+	OutAngleScore = OutDistanceScore = OutPriorityScore = 0.0f;
+
 	if (!Target)
 	{
 		return MAX_FLT;
@@ -334,14 +590,14 @@ float UCameraLockOnComponent::CalculateTargetScore(AActor* Target, const FVector
 	// Score combines angle (how close to center) and distance
 	// Lower angle and distance = better score
 	// Weight angle more heavily so targets closer to center are preferred
-	const float AngleScore = AngleDegrees * 2.0f; // Weight angle more
-	const float DistanceScore = Distance / 100.0f; // Normalize distance
+	OutAngleScore = AngleDegrees * 2.0f; // Weight angle more
+	OutDistanceScore = Distance / 100.0f; // Normalize distance
 
 	// Subtract priority (higher priority = lower score)
 	const int32 Priority = LockOnTarget->GetLockOnPriority();
-	const float PriorityScore = -Priority * 10.0f;
+	OutPriorityScore = -Priority * 10.0f;
 
-	return AngleScore + DistanceScore + PriorityScore;
+	return OutAngleScore + OutDistanceScore + OutPriorityScore;
 }
 
 void UCameraLockOnComponent::UpdateCameraRotation(const float DeltaTime)
@@ -393,9 +649,21 @@ void UCameraLockOnComponent::UpdateCameraRotation(const float DeltaTime)
 
 AActor* UCameraLockOnComponent::FindNextTargetInDirection(const bool bLeft) const
 {
+	AActor* LeftTarget = nullptr;
+	AActor* RightTarget = nullptr;
+	FindNextTargets(LeftTarget, RightTarget);
+
+	return bLeft ? LeftTarget : RightTarget;
+}
+
+void UCameraLockOnComponent::FindNextTargets(AActor*& OutLeftTarget, AActor*& OutRightTarget) const
+{
+	OutLeftTarget = nullptr;
+	OutRightTarget = nullptr;
+
 	if (!LockedOnTarget.IsValid() || !CameraComponent || !OwnerCharacter)
 	{
-		return nullptr;
+		return;
 	}
 
 	const FVector CameraLocation = CameraComponent->GetComponentLocation();
@@ -403,24 +671,24 @@ AActor* UCameraLockOnComponent::FindNextTargetInDirection(const bool bLeft) cons
 	const ILockOnTarget* CurrentLockOnTarget = Cast<ILockOnTarget>(LockedOnTarget.Get());
 	if (!CurrentLockOnTarget)
 	{
-		return nullptr;
+		return;
 	}
 
 	const FVector CurrentTargetLocation = CurrentLockOnTarget->GetLockOnLocation();
 	const FVector DirectionToCurrentTarget = (CurrentTargetLocation - CameraLocation).GetSafeNormal();
 
-	// Find all valid targets
+	// Find all valid targets once, then split them into both sides
 	TArray<AActor*> ValidTargets = FindTargetsInView();
 	if (ValidTargets.Num() <= 1)
 	{
-		return nullptr; // No other targets available
+		return; // No other targets available
 	}
 
 	// Remove current target from list
 	ValidTargets.Remove(LockedOnTarget.Get());
 
-	AActor* BestTarget = nullptr;
-	float BestAngle = MAX_FLT;
+	float BestLeftAngle = MAX_FLT;
+	float BestRightAngle = MAX_FLT;
 
 	for (AActor* Candidate : ValidTargets)
 	{
@@ -432,14 +700,10 @@ AActor* UCameraLockOnComponent::FindNextTargetInDirection(const bool bLeft) cons
 		const FVector CandidateLocation = Cast<ILockOnTarget>(Candidate)->GetLockOnLocation();
 		const FVector DirectionToCandidate = (CandidateLocation - CameraLocation).GetSafeNormal();
 
-		// Determine if candidate is in the desired direction
-		if (const bool bCandidateIsLeft = FVector::DotProduct(
-				FVector::CrossProduct(DirectionToCurrentTarget, DirectionToCandidate),
-				CameraComponent->GetUpVector()) > 0.0f;
-			bCandidateIsLeft != bLeft)
-		{
-			continue;
-		}
+		// Determine which side the candidate is on
+		const bool bCandidateIsLeft = FVector::DotProduct(
+			FVector::CrossProduct(DirectionToCurrentTarget, DirectionToCandidate),
+			CameraComponent->GetUpVector()) > 0.0f;
 
 		// Calculate angle between current target direction and candidate direction
 		const float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(
@@ -448,13 +712,224 @@ AActor* UCameraLockOnComponent::FindNextTargetInDirection(const bool bLeft) cons
 			1.0f
 		)));
 
-		// Find the closest target in the desired direction
+		// Find the closest target on each side
+		float& BestAngle = bCandidateIsLeft ? BestLeftAngle : BestRightAngle;
 		if (Angle < BestAngle)
 		{
 			BestAngle = Angle;
-			BestTarget = Candidate;
+			(bCandidateIsLeft ? OutLeftTarget : OutRightTarget) = Candidate;
 		}
 	}
+}
 
-	return BestTarget;
+bool UCameraLockOnComponent::IsLocallyControlled() const
+{
+	return OwnerCharacter && OwnerCharacter->IsLocallyControlled();
+}
+
+void UCameraLockOnComponent::CommitLockOnState()
+{
+	const ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>();
+
+	FLockOnReplicatedState NewState;
+	NewState.bLockedOn = IsLockedOn();
+	NewState.TargetHandle = NewState.bLockedOn && Registry ? Registry->GetHandle(LockedOnTarget.Get()) : 0;
+	NewState.SwitchSequence = ++LocalSwitchSequence;
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		// we are the server, publish directly
+		ReplicatedState = NewState;
+	}
+	else
+	{
+		// predict locally and let the server confirm
+		ServerSetLockOnState(NewState);
+	}
+}
+
+void UCameraLockOnComponent::ServerSetLockOnState_Implementation(const FLockOnReplicatedState& RequestedState)
+{
+	const ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>();
+	AActor* RequestedTarget = RequestedState.bLockedOn && Registry ? Registry->ResolveHandle(RequestedState.TargetHandle) : nullptr;
+
+	if (!RequestedState.bLockedOn)
+	{
+		// releasing lock-on is always allowed
+		bIsLockedOn = false;
+		LockedOnTarget.Reset();
+	}
+	else if (ValidateLockOnTarget(RequestedTarget))
+	{
+		bIsLockedOn = true;
+		LockedOnTarget = RequestedTarget;
+	}
+	else
+	{
+		UE_LOG(LogCameraProject, Verbose, TEXT("Rejected lock-on request from '%s' for handle %u."), *GetNameSafe(GetOwner()), RequestedState.TargetHandle);
+	}
+
+	// answer with the resulting state, tagged with the request's sequence so the client can reconcile
+	ReplicatedState.bLockedOn = IsLockedOn();
+	ReplicatedState.TargetHandle = ReplicatedState.bLockedOn && Registry ? Registry->GetHandle(LockedOnTarget.Get()) : 0;
+	ReplicatedState.SwitchSequence = RequestedState.SwitchSequence;
+}
+
+void UCameraLockOnComponent::ServerValidateLockOn()
+{
+	if (!bIsLockedOn)
+	{
+		return;
+	}
+
+	const ILockOnTarget* LockOnTarget = Cast<ILockOnTarget>(LockedOnTarget.Get());
+	if (LockOnTarget && LockOnTarget->IsLockOnValid())
+	{
+		return;
+	}
+
+	// clear the lock and replicate it. The sequence is kept, so the owning client accepts it unless it has a newer request in flight
+	bIsLockedOn = false;
+	LockedOnTarget.Reset();
+
+	ReplicatedState.bLockedOn = false;
+	ReplicatedState.TargetHandle = 0;
+}
+
+bool UCameraLockOnComponent::ValidateLockOnTarget(AActor* Target) const
+{
+	if (!Target || !OwnerCharacter)
+	{
+		return false;
+	}
+
+	const ILockOnTarget* LockOnTarget = Cast<ILockOnTarget>(Target);
+	if (!LockOnTarget || !LockOnTarget->IsLockOnValid())
+	{
+		return false;
+	}
+
+	// use the server's view of the camera, falling back to the pawn's eyes
+	const FVector ViewLocation = CameraComponent ? CameraComponent->GetComponentLocation() : OwnerCharacter->GetPawnViewLocation();
+	const FVector TargetLocation = LockOnTarget->GetLockOnLocation();
+
+	// allow some slack on distance to absorb latency
+	if (FVector::Dist(ViewLocation, TargetLocation) > MaxLockOnDistance * ServerDistanceTolerance)
+	{
+		return false;
+	}
+
+	// a single line of sight trace confirms the request
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(OwnerCharacter);
+	QueryParams.AddIgnoredActor(Target);
+
+	FHitResult HitResult;
+	return !GetWorld()->LineTraceSingleByChannel(HitResult, ViewLocation, TargetLocation, ECC_Visibility, QueryParams);
+}
+
+void UCameraLockOnComponent::OnRep_LockOnState()
+{
+	// the owning client only accepts the answer to its latest request, older answers are stale
+	if (IsLocallyControlled() && ReplicatedState.SwitchSequence != LocalSwitchSequence)
+	{
+		return;
+	}
+
+	// mirror or reconcile with the server state
+	const ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>();
+	AActor* ServerTarget = ReplicatedState.bLockedOn && Registry ? Registry->ResolveHandle(ReplicatedState.TargetHandle) : nullptr;
+
+	bIsLockedOn = ServerTarget != nullptr;
+	LockedOnTarget = ServerTarget;
+}
+
+void UCameraLockOnComponent::UpdateReticle(const float DeltaTime)
+{
+	if (!bShowReticle)
+	{
+		return;
+	}
+
+	const APlayerController* PlayerController = OwnerCharacter ? Cast<APlayerController>(OwnerCharacter->GetController()) : nullptr;
+	ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	if (!LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	// Create the overlay the first time we have a local player to show it to
+	if (!ReticleWidget.IsValid())
+	{
+		ReticleWidget = SNew(SLockOnReticle)
+			.PrimaryColor(ReticleColor)
+			.HintColor(ReticleHintColor);
+
+		LocalPlayer->ViewportClient->AddViewportWidgetForPlayer(LocalPlayer, ReticleWidget.ToSharedRef(), 0);
+		ReticlePlayer = LocalPlayer;
+	}
+
+	// Refresh the switch hints at a lower rate, finding them costs overlaps and traces
+	if (IsLockedOn())
+	{
+		ReticleHintRefreshTimer -= DeltaTime;
+		if (ReticleHintRefreshTimer <= 0.0f)
+		{
+			ReticleHintRefreshTimer = ReticleHintRefreshInterval;
+
+			// One search for both sides, so the hints only pay for a single overlap and one share of the trace budget
+			AActor* LeftTarget = nullptr;
+			AActor* RightTarget = nullptr;
+			FindNextTargets(LeftTarget, RightTarget);
+
+			LeftHintTarget = LeftTarget;
+			RightHintTarget = RightTarget;
+		}
+	}
+	else
+	{
+		ReticleHintRefreshTimer = 0.0f;
+		LeftHintTarget.Reset();
+		RightHintTarget.Reset();
+	}
+
+	// Gather the world points to project, locked-on target first
+	TArray<FVector, TInlineAllocator<3>> WorldPoints;
+	if (const ILockOnTarget* Target = Cast<ILockOnTarget>(GetLockedOnTarget()))
+	{
+		WorldPoints.Add(Target->GetLockOnLocation());
+
+		for (const TWeakObjectPtr<AActor>& HintTarget : { LeftHintTarget, RightHintTarget })
+		{
+			if (const ILockOnTarget* Hint = Cast<ILockOnTarget>(HintTarget.Get()); Hint && Hint->IsLockOnValid())
+			{
+				WorldPoints.Add(Hint->GetLockOnLocation());
+			}
+		}
+	}
+
+	TArray<FLockOnReticleMarker, TInlineAllocator<3>> Markers;
+	if (WorldPoints.Num() > 0)
+	{
+		// Build the view projection once and project every point with it
+		FSceneViewProjectionData ProjectionData;
+		if (LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+		{
+			const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+			const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+			for (int32 Index = 0; Index < WorldPoints.Num(); ++Index)
+			{
+				FVector2D ScreenPosition;
+				if (FSceneView::ProjectWorldToScreen(WorldPoints[Index], ViewRect, ViewProjectionMatrix, ScreenPosition))
+				{
+					FLockOnReticleMarker& Marker = Markers.AddDefaulted_GetRef();
+					Marker.Position = FVector2f(ScreenPosition - FVector2D(ViewRect.Min));
+					Marker.bPrimary = Index == 0;
+				}
+			}
+		}
+	}
+
+	ReticleWidget->SetMarkers(Markers);
 }
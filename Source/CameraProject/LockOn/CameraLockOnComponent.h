@@ -4,15 +4,99 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Templates/SharedPointer.h"
 #include "CameraLockOnComponent.generated.h"
 
 class UCameraComponent;
 class USpringArmComponent;
 class ACharacter;
+class SLockOnReticle;
+class ULocalPlayer;
+class ULockOnTargetRegistry;
+
+/** Result of testing a target's lock-on points for line of sight */
+enum class ELockOnVisibility : uint8
+{
+	/** One of the points is visible */
+	Visible,
+
+	/** Every point is obstructed */
+	Hidden,
+
+	/** The trace budget ran out before a conclusive result */
+	OutOfBudget
+};
+
+/**
+ *  Compact replicated lock-on state
+ *  Serialized as a lock flag, a quantized target handle (only while locked) and a switch sequence counter
+ */
+USTRUCT()
+struct FLockOnReplicatedState
+{
+	GENERATED_BODY()
+
+	/** Registry handle of the locked-on target. 0 means no target */
+	UPROPERTY()
+	uint16 TargetHandle = 0;
+
+	/** Whether lock-on is active */
+	UPROPERTY()
+	bool bLockedOn = false;
+
+	/** Incremented by the owning client on every lock-on change so the server's answer can be matched to the request */
+	UPROPERTY()
+	uint8 SwitchSequence = 0;
+
+	/** Custom bit-packed serialization */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FLockOnReplicatedState& Other) const
+	{
+		return TargetHandle == Other.TargetHandle && bLockedOn == Other.bLockedOn && SwitchSequence == Other.SwitchSequence;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FLockOnReplicatedState> : public TStructOpsTypeTraitsBase2<FLockOnReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+#if WITH_GAMEPLAY_DEBUGGER
+/** Debug record for a single candidate evaluated by the last lock-on query */
+struct FLockOnDebugCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+	float Score = 0.0f;
+	float AngleScore = 0.0f;
+	float DistanceScore = 0.0f;
+	float PriorityScore = 0.0f;
+	int32 Traces = 0;
+	bool bVisible = false;
+	bool bOverBudget = false;
+};
+
+/** Debug record for the last lock-on query, displayed by the LockOn gameplay debugger category */
+struct FLockOnDebugQuery
+{
+	TArray<FLockOnDebugCandidate> Candidates;
+	double OverlapMicroseconds = 0.0;
+	double FilterMicroseconds = 0.0;
+	double LineOfSightMicroseconds = 0.0;
+	uint64 Frame = 0;
+};
+#endif
 
 /**
  * Component that handles camera lock-on functionality similar to Dark Souls
  * Detects targets within camera field of view, selects the best target, and smoothly interpolates camera rotation
+ * In multiplayer the owning client predicts lock-on locally and the server validates and replicates the result
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class CAMERAPROJECT_API UCameraLockOnComponent : public UActorComponent
@@ -25,8 +109,12 @@ public:
 protected:
 	virtual void BeginPlay() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
+	/** Sets up replicated properties */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	/** Enable or disable lock-on */
 	UFUNCTION(BlueprintCallable, Category="LockOn")
 	void SetLockOnEnabled(bool bEnabled);
@@ -51,6 +139,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category="LockOn")
 	AActor* GetLockedOnTarget() const { return LockedOnTarget.Get(); }
 
+	/** Returns the average number of line of sight traces spent per tested target since play started */
+	UFUNCTION(BlueprintCallable, Category="LockOn")
+	float GetAverageTracesPerTarget() const;
+
+	/**
+	 *  Tests lock-on points in preference order and stops at the first visible one.
+	 *  Each test first reserves a trace through ConsumeTrace; if that fails before a conclusive result, returns OutOfBudget.
+	 *  Optionally returns the index of the visible point and the number of traces spent.
+	 */
+	static ELockOnVisibility EvaluateLockOnPoints(TConstArrayView<FVector> Points, TFunctionRef<bool()> ConsumeTrace,
+	                                              TFunctionRef<bool(const FVector&)> IsPointVisible, int32* OutVisibleIndex = nullptr, int32* OutNumTraces = nullptr);
+
+#if WITH_GAMEPLAY_DEBUGGER
+	/** Enables debug recording of target queries for the next few frames. Called by the gameplay debugger while active */
+	void RequestDebugRecording(uint64 NumFrames) const;
+
+	/** Returns the debug record of the last recorded target query */
+	const FLockOnDebugQuery& GetLastDebugQuery() const { return LastDebugQuery; }
+#endif
+
 protected:
 	/** Find all valid targets within camera field of view */
 	TArray<AActor*> FindTargetsInView() const;
@@ -58,21 +166,61 @@ protected:
 	/** Check if a target is within the camera's field of view */
 	static bool IsTargetInView(AActor* Target, const FVector& CameraLocation, const FVector& CameraForward, float FOV);
 
-	/** Check if there's a clear line of sight to the target */
+	/**
+	 *  Check if there's a clear line of sight to any of the target's lock-on points.
+	 *  Points are tested in preference order and the test stops at the first visible one.
+	 *  Traces are charged against the world's per-frame budget. Once it runs out, the target's last known result is kept.
+	 */
 	bool HasLineOfSight(AActor* Target, const FVector& CameraLocation) const;
 
+	/** Returns the lock-on target registry, which holds the world's trace budget */
+	ULockOnTargetRegistry* GetTargetRegistry() const;
+
 	/** Select the best target from a list of candidates */
 	static AActor* SelectBestTarget(const TArray<AActor*>& Candidates, const FVector& CameraLocation, const FVector& CameraForward);
 
+	/** Validates the current target, retargets if needed and rotates the camera. Locally controlled only */
+	void UpdateLockOn(float DeltaTime);
+
+	/** Projects the locked-on target and switch hints in one batch and pushes them to the reticle overlay */
+	void UpdateReticle(float DeltaTime);
+
 	/** Update camera rotation to face the locked-on target */
 	void UpdateCameraRotation(float DeltaTime);
 
 	/** Calculate score for a target (lower is better, targets closer to center of screen win) */
 	static float CalculateTargetScore(AActor* Target, const FVector& CameraLocation, const FVector& CameraForward);
 
+	/** Calculate score for a target and output the individual angle, distance and priority terms */
+	static float CalculateTargetScoreBreakdown(AActor* Target, const FVector& CameraLocation, const FVector& CameraForward,
+	                                           float& OutAngleScore, float& OutDistanceScore, float& OutPriorityScore);
+
 	/** Find the next target to the left or right of current target */
 	AActor* FindNextTargetInDirection(bool bLeft) const;
 
+	/** Find the next targets to both the left and the right of current target with a single target search */
+	void FindNextTargets(AActor*& OutLeftTarget, AActor*& OutRightTarget) const;
+
+	/** Returns true if this component belongs to a locally controlled character */
+	bool IsLocallyControlled() const;
+
+	/** Publishes a local lock-on change: applied directly with authority, otherwise sent to the server for validation */
+	void CommitLockOnState();
+
+	/** Asks the server to confirm a lock-on state predicted by the owning client */
+	UFUNCTION(Server, Reliable)
+	void ServerSetLockOnState(const FLockOnReplicatedState& RequestedState);
+
+	/** Server-side check for remote players: clears and replicates a lock whose target is no longer valid */
+	void ServerValidateLockOn();
+
+	/** Server-side check that the requested target can be locked on to, using a single line of sight trace */
+	bool ValidateLockOnTarget(AActor* Target) const;
+
+	/** Applies the replicated lock-on state on clients */
+	UFUNCTION()
+	void OnRep_LockOnState();
+
 private:
 	/** Whether lock-on is currently active */
 	UPROPERTY(VisibleAnywhere, Category="LockOn")
@@ -106,6 +254,65 @@ private:
 	UPROPERTY(EditAnywhere, Category="LockOn|Camera", meta=(ClampMin=0.0f, ClampMax=45.0f, Units="deg"))
 	float DeadZoneAngle = 2.0f;
 
+	/** If true, a native reticle overlay marks the locked-on target and the targets a switch would pick */
+	UPROPERTY(EditAnywhere, Category="LockOn|Reticle")
+	bool bShowReticle = true;
+
+	/** Color of the locked-on target reticle */
+	UPROPERTY(EditAnywhere, Category="LockOn|Reticle")
+	FLinearColor ReticleColor = FLinearColor(1.0f, 0.85f, 0.3f, 1.0f);
+
+	/** Color of the switch hint reticles */
+	UPROPERTY(EditAnywhere, Category="LockOn|Reticle")
+	FLinearColor ReticleHintColor = FLinearColor(1.0f, 1.0f, 1.0f, 0.4f);
+
+	/** Time between switch hint searches */
+	UPROPERTY(EditAnywhere, Category="LockOn|Reticle", meta=(ClampMin=0.0f, ClampMax=2.0f, Units="s"))
+	float ReticleHintRefreshInterval = 0.25f;
+
+	/** Reticle overlay widget */
+	TSharedPtr<SLockOnReticle> ReticleWidget;
+
+	/** Local player the reticle overlay was added for */
+	TWeakObjectPtr<ULocalPlayer> ReticlePlayer;
+
+	/** Target a switch to the left would pick, for the reticle hints */
+	TWeakObjectPtr<AActor> LeftHintTarget;
+
+	/** Target a switch to the right would pick, for the reticle hints */
+	TWeakObjectPtr<AActor> RightHintTarget;
+
+	/** Time left until the next switch hint search */
+	float ReticleHintRefreshTimer = 0.0f;
+
+	/** Multiplier on MaxLockOnDistance the server allows when validating client lock-on requests, to absorb latency */
+	UPROPERTY(EditAnywhere, Category="LockOn|Network", meta=(ClampMin=1.0f, ClampMax=2.0f))
+	float ServerDistanceTolerance = 1.2f;
+
+	/** Server-confirmed lock-on state, replicated to every client so they can mirror it */
+	UPROPERTY(ReplicatedUsing=OnRep_LockOnState)
+	FLockOnReplicatedState ReplicatedState;
+
+	/** Sequence number of the last lock-on change predicted by the owning client */
+	uint8 LocalSwitchSequence = 0;
+
+	/** Last conclusive line of sight result per target, used while the trace budget is exhausted */
+	mutable TMap<TWeakObjectPtr<AActor>, bool> LastKnownVisibility;
+
+	/** Total line of sight traces performed, for telemetry */
+	mutable int64 TotalLineOfSightTraces = 0;
+
+	/** Total targets that went through a line of sight test, for telemetry */
+	mutable int64 TotalLineOfSightTargets = 0;
+
+#if WITH_GAMEPLAY_DEBUGGER
+	/** Last frame target queries should be recorded for debugging */
+	mutable uint64 DebugRecordUntilFrame = 0;
+
+	/** Debug record of the last recorded target query */
+	mutable FLockOnDebugQuery LastDebugQuery;
+#endif
+
 	/** Cached reference to the owning character */
 	UPROPERTY()
 	ACharacter* OwnerCharacter = nullptr;
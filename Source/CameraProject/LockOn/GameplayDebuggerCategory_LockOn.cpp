@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameplayDebuggerCategory_LockOn.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CameraLockOnComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+namespace LockOnDebugger
+{
+	/** Number of frames a single collect keeps query recording enabled on the component */
+	constexpr uint64 RecordingFrames = 30;
+}
+
+FGameplayDebuggerCategory_LockOn::FGameplayDebuggerCategory_LockOn()
+{
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_LockOn::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_LockOn());
+}
+
+void FGameplayDebuggerCategory_LockOn::FRepData::Serialize(FArchive& Ar)
+{
+	int32 NumCandidates = Candidates.Num();
+	Ar << NumCandidates;
+	if (Ar.IsLoading())
+	{
+		Candidates.SetNum(NumCandidates);
+	}
+
+	for (FRepCandidate& Candidate : Candidates)
+	{
+		Ar << Candidate.Name;
+		Ar << Candidate.Score;
+		Ar << Candidate.AngleScore;
+		Ar << Candidate.DistanceScore;
+		Ar << Candidate.PriorityScore;
+		Ar << Candidate.Traces;
+		Ar << Candidate.bVisible;
+		Ar << Candidate.bOverBudget;
+		Ar << Candidate.bLockedOn;
+	}
+
+	Ar << OverlapMicroseconds;
+	Ar << FilterMicroseconds;
+	Ar << LineOfSightMicroseconds;
+	Ar << FramesSinceQuery;
+	Ar << AverageTracesPerTarget;
+	Ar << bHasComponent;
+	Ar << bIsLockedOn;
+}
+
+void FGameplayDebuggerCategory_LockOn::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack = FRepData();
+
+	// the category always inspects the debugger owner's own lock-on component
+	const APawn* Pawn = OwnerPC ? OwnerPC->GetPawn() : nullptr;
+	const UCameraLockOnComponent* LockOn = Pawn ? Pawn->FindComponentByClass<UCameraLockOnComponent>() : nullptr;
+	if (!LockOn)
+	{
+		return;
+	}
+
+	// keep recording queries while we're being collected. Recording lapses on its own once the category is closed
+	LockOn->RequestDebugRecording(LockOnDebugger::RecordingFrames);
+
+	const FLockOnDebugQuery& Query = LockOn->GetLastDebugQuery();
+	const AActor* LockedOnTarget = LockOn->GetLockedOnTarget();
+
+	DataPack.bHasComponent = true;
+	DataPack.bIsLockedOn = LockOn->IsLockedOn();
+	DataPack.AverageTracesPerTarget = LockOn->GetAverageTracesPerTarget();
+	DataPack.OverlapMicroseconds = Query.OverlapMicroseconds;
+	DataPack.FilterMicroseconds = Query.FilterMicroseconds;
+	DataPack.LineOfSightMicroseconds = Query.LineOfSightMicroseconds;
+	DataPack.FramesSinceQuery = Query.Frame > 0 ? static_cast<uint32>(GFrameCounter - Query.Frame) : MAX_uint32;
+
+	for (const FLockOnDebugCandidate& Candidate : Query.Candidates)
+	{
+		FRepCandidate& RepCandidate = DataPack.Candidates.AddDefaulted_GetRef();
+		RepCandidate.Name = GetNameSafe(Candidate.Actor.Get());
+		RepCandidate.Score = Candidate.Score;
+		RepCandidate.AngleScore = Candidate.AngleScore;
+		RepCandidate.DistanceScore = Candidate.DistanceScore;
+		RepCandidate.PriorityScore = Candidate.PriorityScore;
+		RepCandidate.Traces = Candidate.Traces;
+		RepCandidate.bVisible = Candidate.bVisible;
+		RepCandidate.bOverBudget = Candidate.bOverBudget;
+		RepCandidate.bLockedOn = LockedOnTarget && Candidate.Actor.Get() == LockedOnTarget;
+
+		// mark the candidate in the world
+		const FColor ShapeColor = Candidate.bVisible ? FColor::Green : (Candidate.bOverBudget ? FColor::Orange : FColor::Red);
+		AddShape(FGameplayDebuggerShape::MakePoint(Candidate.Location, RepCandidate.bLockedOn ? 20.0f : 10.0f, ShapeColor, RepCandidate.Name));
+	}
+}
+
+void FGameplayDebuggerCategory_LockOn::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	if (!DataPack.bHasComponent)
+	{
+		CanvasContext.Printf(TEXT("{red}No UCameraLockOnComponent on the local pawn"));
+		return;
+	}
+
+	CanvasContext.Printf(TEXT("Locked on: %s  Avg traces/target: {yellow}%.2f"), DataPack.bIsLockedOn ? TEXT("{green}yes{white}") : TEXT("{grey}no{white}"), DataPack.AverageTracesPerTarget);
+
+	if (DataPack.FramesSinceQuery == MAX_uint32)
+	{
+		CanvasContext.Printf(TEXT("{grey}No query recorded yet"));
+		return;
+	}
+
+	CanvasContext.Printf(TEXT("Last query: %u frames ago  overlap {yellow}%.1fus{white}  filter {yellow}%.1fus{white}  LOS {yellow}%.1fus"),
+		DataPack.FramesSinceQuery, DataPack.OverlapMicroseconds, DataPack.FilterMicroseconds, DataPack.LineOfSightMicroseconds);
+
+	for (const FRepCandidate& Candidate : DataPack.Candidates)
+	{
+		const TCHAR* LOSText = Candidate.bVisible ? TEXT("{green}visible") : (Candidate.bOverBudget ? TEXT("{orange}over budget") : TEXT("{red}occluded"));
+
+		CanvasContext.Printf(TEXT("%s%s{white}  score %.1f (angle %.1f, dist %.1f, prio %.1f)  LOS %s{white} in %d traces"),
+			Candidate.bLockedOn ? TEXT("{green}> ") : TEXT("{white}  "), *Candidate.Name,
+			Candidate.Score, Candidate.AngleScore, Candidate.DistanceScore, Candidate.PriorityScore,
+			LOSText, Candidate.Traces);
+	}
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
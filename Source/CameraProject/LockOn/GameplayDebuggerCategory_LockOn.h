@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+class APlayerController;
+class AActor;
+
+/**
+ *  Gameplay Debugger category for the camera lock-on system
+ *  Shows the local player's last lock-on query: score breakdown and line of sight result per candidate,
+ *  and the time spent in each query phase.
+ *  Query recording on the lock-on component is only enabled while this category is collecting data.
+ */
+class FGameplayDebuggerCategory_LockOn : public FGameplayDebuggerCategory
+{
+public:
+
+	/** Constructor */
+	FGameplayDebuggerCategory_LockOn();
+
+	/** Gathers the lock-on data for the debugger owner */
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+
+	/** Draws the collected data on the debugger canvas */
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+	/** Creates an instance of this category for the debugger */
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+
+	/** Replicated summary of a single candidate */
+	struct FRepCandidate
+	{
+		FString Name;
+		float Score = 0.0f;
+		float AngleScore = 0.0f;
+		float DistanceScore = 0.0f;
+		float PriorityScore = 0.0f;
+		int32 Traces = 0;
+		bool bVisible = false;
+		bool bOverBudget = false;
+		bool bLockedOn = false;
+	};
+
+	/** Replicated data pack */
+	struct FRepData
+	{
+		TArray<FRepCandidate> Candidates;
+		double OverlapMicroseconds = 0.0;
+		double FilterMicroseconds = 0.0;
+		double LineOfSightMicroseconds = 0.0;
+		uint32 FramesSinceQuery = 0;
+		float AverageTracesPerTarget = 0.0f;
+		bool bHasComponent = false;
+		bool bIsLockedOn = false;
+
+		void Serialize(FArchive& Ar);
+	};
+
+	/** Data pack sent to the debugger client */
+	FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
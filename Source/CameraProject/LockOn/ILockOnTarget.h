@@ -26,6 +26,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="LockOn")
 	virtual FVector GetLockOnLocation() const = 0;
 
+	/**
+	 *  Appends the world locations the lock-on system may test for visibility, ranked by preference (most preferred first).
+	 *  Partially occluded targets stay lockable as long as any of these points is visible.
+	 *  Defaults to the single GetLockOnLocation point.
+	 */
+	UFUNCTION(BlueprintCallable, Category="LockOn")
+	virtual void GetLockOnLocations(TArray<FVector>& OutLocations) const { OutLocations.Add(GetLockOnLocation()); }
+
 	/** Returns true if this target is currently valid for lock-on (e.g., not dead, not destroyed) */
 	UFUNCTION(BlueprintCallable, Category="LockOn")
 	virtual bool IsLockOnValid() const = 0;
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LockOnTargetRegistry.h"
+#include "GameFramework/Actor.h"
+#include "CameraProject.h"
+
+uint16 ULockOnTargetRegistry::RegisterTarget(AActor* Target)
+{
+	if (!Target)
+	{
+		return 0;
+	}
+
+	// reuse the existing handle if the target is already registered
+	if (const uint16* ExistingHandle = TargetToHandle.Find(Target))
+	{
+		return *ExistingHandle;
+	}
+
+	// cycle through the handle space looking for a free slot
+	for (uint32 Attempt = 1; Attempt < LockOnTargetHandleMax; ++Attempt)
+	{
+		const uint16 Handle = NextHandle;
+		NextHandle = static_cast<uint16>(NextHandle + 1 < LockOnTargetHandleMax ? NextHandle + 1 : 1);
+
+		// is this slot free or held by a destroyed target?
+		const TWeakObjectPtr<AActor>* Existing = HandleToTarget.Find(Handle);
+		if (!Existing || !Existing->IsValid())
+		{
+			// forget the destroyed target that held the slot, so its stale key doesn't linger
+			if (Existing)
+			{
+				TargetToHandle.Remove(*Existing);
+			}
+
+			HandleToTarget.Add(Handle, Target);
+			TargetToHandle.Add(Target, Handle);
+			return Handle;
+		}
+	}
+
+	UE_LOG(LogCameraProject, Warning, TEXT("Lock-on target registry is full, '%s' can't be targeted over the network."), *GetNameSafe(Target));
+	return 0;
+}
+
+void ULockOnTargetRegistry::RegisterTargetWithHandle(AActor* Target, const uint16 Handle)
+{
+	if (!Target || Handle == 0)
+	{
+		return;
+	}
+
+	// drop any previous mapping for this target
+	UnregisterTarget(Target);
+
+	HandleToTarget.Add(Handle, Target);
+	TargetToHandle.Add(Target, Handle);
+}
+
+void ULockOnTargetRegistry::UnregisterTarget(AActor* Target)
+{
+	uint16 Handle = 0;
+	if (TargetToHandle.RemoveAndCopyValue(Target, Handle))
+	{
+		// only free the slot if it still belongs to this target
+		if (const TWeakObjectPtr<AActor>* Existing = HandleToTarget.Find(Handle); Existing && Existing->Get() == Target)
+		{
+			HandleToTarget.Remove(Handle);
+		}
+	}
+}
+
+uint16 ULockOnTargetRegistry::GetHandle(const AActor* Target) const
+{
+	// the map keys are non-const weak pointers, which can't be made from a const pointer implicitly
+	const uint16* Handle = TargetToHandle.Find(TWeakObjectPtr<AActor>(const_cast<AActor*>(Target)));
+	return Handle ? *Handle : 0;
+}
+
+AActor* ULockOnTargetRegistry::ResolveHandle(const uint16 Handle) const
+{
+	const TWeakObjectPtr<AActor>* Target = HandleToTarget.Find(Handle);
+	return Target ? Target->Get() : nullptr;
+}
+
+bool ULockOnTargetRegistry::ConsumeLineOfSightTrace(const uint64 Frame)
+{
+	// reset the budget on the first trace of a new frame
+	if (LineOfSightBudgetFrame != Frame)
+	{
+		LineOfSightBudgetFrame = Frame;
+		LineOfSightTracesThisFrame = 0;
+	}
+
+	if (LineOfSightTracesThisFrame >= MaxLineOfSightTracesPerFrame)
+	{
+		return false;
+	}
+
+	++LineOfSightTracesThisFrame;
+	return true;
+}
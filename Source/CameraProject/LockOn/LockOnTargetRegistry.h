@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LockOnTargetRegistry.generated.h"
+
+/** Number of bits used to replicate a lock-on target handle */
+static constexpr uint32 LockOnTargetHandleBits = 12;
+
+/** Exclusive upper bound for lock-on target handles. Handle 0 is reserved for "no target" */
+static constexpr uint32 LockOnTargetHandleMax = 1u << LockOnTargetHandleBits;
+
+/**
+ *  World subsystem that maps lock-on targets to compact handles.
+ *  The server assigns handles and targets replicate theirs to clients, so lock-on state
+ *  can reference a target with a few bits instead of a full object reference.
+ *  It also holds the line of sight trace budget shared by every lock-on component in the world.
+ */
+UCLASS(Config=Game)
+class ULockOnTargetRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Reserves one line of sight trace from this frame's world budget. Returns false if the budget is exhausted */
+	bool ConsumeLineOfSightTrace() { return ConsumeLineOfSightTrace(GFrameCounter); }
+
+	/** Reserves one line of sight trace from the given frame's world budget. Returns false if the budget is exhausted */
+	bool ConsumeLineOfSightTrace(uint64 Frame);
+
+	/** Returns the number of line of sight traces spent so far this frame */
+	int32 GetLineOfSightTracesThisFrame() const { return LineOfSightBudgetFrame == GFrameCounter ? LineOfSightTracesThisFrame : 0; }
+
+	/** Returns the world's line of sight trace budget per frame */
+	int32 GetMaxLineOfSightTracesPerFrame() const { return MaxLineOfSightTracesPerFrame; }
+
+	/** Assigns a new handle to the target. Server only. Returns 0 if the registry is full */
+	uint16 RegisterTarget(AActor* Target);
+
+	/** Registers a target with a handle assigned by the server. Client only */
+	void RegisterTargetWithHandle(AActor* Target, uint16 Handle);
+
+	/** Removes the target from the registry */
+	void UnregisterTarget(AActor* Target);
+
+	/** Returns the handle for the target, or 0 if it isn't registered */
+	uint16 GetHandle(const AActor* Target) const;
+
+	/** Returns the target for the handle, or nullptr if it isn't registered */
+	AActor* ResolveHandle(uint16 Handle) const;
+
+protected:
+
+	/** Handle to target map */
+	TMap<uint16, TWeakObjectPtr<AActor>> HandleToTarget;
+
+	/** Target to handle map */
+	TMap<TWeakObjectPtr<AActor>, uint16> TargetToHandle;
+
+	/** Next handle to try when assigning. Handles are cycled to avoid reusing a recently freed one */
+	uint16 NextHandle = 1;
+
+	/** Maximum number of line of sight traces shared by all lock-on components in a single frame */
+	UPROPERTY(Config)
+	int32 MaxLineOfSightTracesPerFrame = 16;
+
+	/** Frame counter value the trace budget was last reset on */
+	uint64 LineOfSightBudgetFrame = 0;
+
+	/** Number of line of sight traces already spent this frame */
+	int32 LineOfSightTracesThisFrame = 0;
+};
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SLockOnReticle.h"
+#include "Rendering/DrawElements.h"
+
+namespace LockOnReticle
+{
+	/** Movement below this many pixels doesn't trigger a repaint */
+	constexpr float InvalidationThresholdPixels = 1.0f;
+}
+
+void SLockOnReticle::Construct(const FArguments& InArgs)
+{
+	PrimaryColor = InArgs._PrimaryColor;
+	HintColor = InArgs._HintColor;
+	PrimarySize = InArgs._PrimarySize;
+	HintSize = InArgs._HintSize;
+}
+
+void SLockOnReticle::SetMarkers(TConstArrayView<FLockOnReticleMarker> NewMarkers)
+{
+	// check if anything changed enough to be visible
+	bool bChanged = NewMarkers.Num() != Markers.Num();
+	for (int32 Index = 0; !bChanged && Index < NewMarkers.Num(); ++Index)
+	{
+		bChanged = NewMarkers[Index].bPrimary != Markers[Index].bPrimary
+			|| FVector2f::DistSquared(NewMarkers[Index].Position, Markers[Index].Position) > FMath::Square(LockOnReticle::InvalidationThresholdPixels);
+	}
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	Markers.Reset();
+	Markers.Append(NewMarkers.GetData(), NewMarkers.Num());
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SLockOnReticle::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// markers are in pixels, convert to local slate units
+	const float InverseScale = AllottedGeometry.Scale > 0.0f ? 1.0f / AllottedGeometry.Scale : 1.0f;
+
+	TArray<FVector2f> Points;
+	Points.Reserve(5);
+
+	for (const FLockOnReticleMarker& Marker : Markers)
+	{
+		const FVector2f Center = Marker.Position * InverseScale;
+		const float HalfSize = (Marker.bPrimary ? PrimarySize : HintSize) * 0.5f;
+
+		// draw a diamond around the target
+		Points.Reset();
+		Points.Add(Center + FVector2f(0.0f, -HalfSize));
+		Points.Add(Center + FVector2f(HalfSize, 0.0f));
+		Points.Add(Center + FVector2f(0.0f, HalfSize));
+		Points.Add(Center + FVector2f(-HalfSize, 0.0f));
+		Points.Add(Center + FVector2f(0.0f, -HalfSize));
+
+		FSlateDrawElement::MakeLines(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.ToPaintGeometry(),
+			Points,
+			ESlateDrawEffect::None,
+			(Marker.bPrimary ? PrimaryColor : HintColor) * InWidgetStyle.GetColorAndOpacityTint(),
+			true,
+			Marker.bPrimary ? 2.0f : 1.0f);
+	}
+
+	return LayerId;
+}
+
+FVector2D SLockOnReticle::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// the overlay fills whatever space the viewport gives it
+	return FVector2D::ZeroVector;
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+/** A single reticle drawn by SLockOnReticle, in viewport pixels */
+struct FLockOnReticleMarker
+{
+	/** Projected position relative to the player's view rect */
+	FVector2f Position = FVector2f::ZeroVector;
+
+	/** True for the locked-on target, false for switch hints */
+	bool bPrimary = false;
+};
+
+/**
+ *  Native Slate overlay that draws the lock-on reticle and switch hints.
+ *  Markers are pushed in by UCameraLockOnComponent once per frame; the widget only
+ *  invalidates its paint when a marker moves by more than a pixel or the marker set changes.
+ */
+class SLockOnReticle : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SLockOnReticle)
+		: _PrimaryColor(FLinearColor::White)
+		, _HintColor(FLinearColor(1.0f, 1.0f, 1.0f, 0.4f))
+		, _PrimarySize(48.0f)
+		, _HintSize(24.0f)
+	{
+		_Visibility = EVisibility::HitTestInvisible;
+	}
+		SLATE_ARGUMENT(FLinearColor, PrimaryColor)
+		SLATE_ARGUMENT(FLinearColor, HintColor)
+		SLATE_ARGUMENT(float, PrimarySize)
+		SLATE_ARGUMENT(float, HintSize)
+	SLATE_END_ARGS()
+
+	/** Constructs the widget */
+	void Construct(const FArguments& InArgs);
+
+	/** Replaces the markers. Only invalidates paint if something visibly changed */
+	void SetMarkers(TConstArrayView<FLockOnReticleMarker> NewMarkers);
+
+	// ~begin SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	// ~end SWidget interface
+
+protected:
+
+	/** Markers currently drawn */
+	TArray<FLockOnReticleMarker> Markers;
+
+	/** Locked-on target reticle color */
+	FLinearColor PrimaryColor;
+
+	/** Switch hint reticle color */
+	FLinearColor HintColor;
+
+	/** Locked-on target reticle size, in slate units */
+	float PrimarySize = 48.0f;
+
+	/** Switch hint reticle size, in slate units */
+	float HintSize = 24.0f;
+};
@@ -0,0 +1,250 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AITickLODTest.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "AIController.h"
+#include "AI/AITickLODSubsystem.h"
+
+UAITickLODTestBrainComponent::UAITickLODTestBrainComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void UAITickLODTestBrainComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	TickDeltas.Add(DeltaTime);
+	TickFrames.Add(CurrentFrame);
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AITickLODTest
+{
+	/** Simulated frame time */
+	static constexpr float DeltaTime = 1.0f / 60.0f;
+
+	/** Number of simulated agents */
+	static constexpr int32 NumAgents = 100;
+
+	/** Distances from the player for the agents of each tier */
+	static constexpr double NearAgentDistance = 500.0;
+	static constexpr double MidAgentDistance = 3000.0;
+	static constexpr double FarAgentDistance = 10000.0;
+
+	/** Spawns a bare pawn at the location */
+	static APawn* SpawnPawn(UWorld* World, const FVector& Location)
+	{
+		APawn* Pawn = World->SpawnActor<APawn>();
+		USceneComponent* Root = NewObject<USceneComponent>(Pawn, TEXT("Root"));
+		Pawn->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Pawn->SetActorLocation(Location);
+
+		return Pawn;
+	}
+
+	/** Spawns an AI controller with a recording brain, possessing a pawn at the distance from the origin, and registers it for tick LOD */
+	static UAITickLODTestBrainComponent* SpawnAgent(UWorld* World, UAITickLODSubsystem& TickLOD, const double Distance)
+	{
+		AAIController* Controller = World->SpawnActor<AAIController>();
+
+		UAITickLODTestBrainComponent* Brain = NewObject<UAITickLODTestBrainComponent>(Controller, TEXT("Brain"));
+		Brain->RegisterComponent();
+
+		Controller->Possess(SpawnPawn(World, FVector(Distance, 0.0, 0.0)));
+		TickLOD.RegisterAgent(Brain);
+
+		return Brain;
+	}
+}
+
+// Test: Tick Interval Tiers by Distance
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAITickLODTiersTest,
+	"CameraProject.AI.TickLOD.Tiers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAITickLODTiersTest::RunTest(const FString& Parameters)
+{
+	const UAITickLODSubsystem* TickLOD = NewObject<UAITickLODSubsystem>(GetTransientPackage());
+
+	// intervals should never shrink with distance
+	float LastInterval = 0.0f;
+
+	for (double Distance = 0.0; Distance <= 10000.0; Distance += 250.0)
+	{
+		const float Interval = TickLOD->GetTickIntervalForDistance(Distance);
+		TestTrue(FString::Printf(TEXT("Interval at %.0f should not be shorter than closer agents'"), Distance), Interval >= LastInterval);
+		LastInterval = Interval;
+	}
+
+	// the closest agents always tick every frame, the furthest ones never tick faster than mid range
+	TestEqual(TEXT("Agents on top of the player should tick every frame"), TickLOD->GetTickIntervalForDistance(0.0), 0.0f);
+	TestTrue(TEXT("Far agents should tick at most as often as mid range agents"), TickLOD->GetTickIntervalForDistance(100000.0) >= TickLOD->GetTickIntervalForDistance(3000.0));
+
+	return true;
+}
+
+// Test: Round-Robin Evaluation Throttles Real Brains
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FAITickLODRoundRobinTest,
+	"CameraProject.AI.TickLOD.RoundRobin",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAITickLODRoundRobinTest::RunTest(const FString& Parameters)
+{
+	using namespace AITickLODTest;
+
+	// headless game world with a player and one agent per tier, plus a crowd of far agents
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AITickLODRoundRobin"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	UAITickLODSubsystem* TickLOD = World->GetSubsystem<UAITickLODSubsystem>();
+
+	if (!TestNotNull(TEXT("Game worlds should have the tick LOD subsystem"), TickLOD))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	TestEqual(TEXT("No agents means nothing to evaluate"), TickLOD->GetNumToEvaluate(0, DeltaTime), 0);
+	TestEqual(TEXT("A single agent is always evaluated"), TickLOD->GetNumToEvaluate(1, DeltaTime), 1);
+	TestEqual(TEXT("A long frame evaluates every agent"), TickLOD->GetNumToEvaluate(NumAgents, 10.0f), NumAgents);
+
+	APlayerController* Player = World->SpawnActor<APlayerController>();
+	Player->Possess(SpawnPawn(World, FVector::ZeroVector));
+
+	UAITickLODTestBrainComponent* NearBrain = SpawnAgent(World, *TickLOD, NearAgentDistance);
+	UAITickLODTestBrainComponent* MidBrain = SpawnAgent(World, *TickLOD, MidAgentDistance);
+	UAITickLODTestBrainComponent* FarBrain = SpawnAgent(World, *TickLOD, FarAgentDistance);
+
+	TArray<UAITickLODTestBrainComponent*> CrowdBrains;
+
+	for (int32 i = 0; i < NumAgents; ++i)
+	{
+		CrowdBrains.Add(SpawnAgent(World, *TickLOD, FarAgentDistance + 100.0 * i));
+	}
+
+	const int32 NumTotalAgents = NumAgents + 3;
+	const int32 NumPerFrame = TickLOD->GetNumToEvaluate(NumTotalAgents, DeltaTime);
+	TestTrue(TEXT("Evaluation should be sliced over several frames"), NumPerFrame < NumTotalAgents);
+
+	const float MidInterval = TickLOD->GetTickIntervalForDistance(MidAgentDistance);
+	const float FarInterval = TickLOD->GetTickIntervalForDistance(FarAgentDistance);
+
+	// run until every agent has been evaluated once, noting the frame each one got its interval
+	TArray<UAITickLODTestBrainComponent*> AllBrains = CrowdBrains;
+	AllBrains.Append({ NearBrain, MidBrain, FarBrain });
+
+	int32 Frame = 0;
+
+	auto TickWorld = [&]()
+	{
+		for (UAITickLODTestBrainComponent* Brain : AllBrains)
+		{
+			Brain->CurrentFrame = Frame;
+		}
+
+		World->Tick(LEVELTICK_All, DeltaTime);
+		++Frame;
+	};
+
+	auto AllEvaluated = [&]()
+	{
+		return !CrowdBrains.ContainsByPredicate([](const UAITickLODTestBrainComponent* Brain) { return Brain->GetComponentTickInterval() <= 0.0f; })
+			&& MidBrain->GetComponentTickInterval() > 0.0f && FarBrain->GetComponentTickInterval() > 0.0f;
+	};
+
+	while (!AllEvaluated() && Frame < 1000)
+	{
+		TickWorld();
+	}
+
+	// the subsystem should have set the tier intervals on the brains themselves
+	TestTrue(TEXT("Every agent should be evaluated within a second"), Frame * DeltaTime <= 1.0f);
+	TestEqual(TEXT("Near agents should tick every frame"), NearBrain->GetComponentTickInterval(), 0.0f);
+	TestEqual(TEXT("Mid range agents should tick at the mid rate"), MidBrain->GetComponentTickInterval(), MidInterval);
+	TestEqual(TEXT("Far agents should tick at the far rate"), FarBrain->GetComponentTickInterval(), FarInterval);
+
+	// let the throttled ticks run for a few far intervals
+	const int32 FirstMeasuredFrame = Frame;
+	const int32 NumMeasuredFrames = FMath::CeilToInt32(FarInterval * 4.0f / DeltaTime);
+
+	TArray<int32> CrowdTicksBefore;
+
+	for (const UAITickLODTestBrainComponent* Brain : CrowdBrains)
+	{
+		CrowdTicksBefore.Add(Brain->TickFrames.Num());
+	}
+
+	const int32 FarTicksBefore = FarBrain->TickDeltas.Num();
+
+	for (int32 i = 0; i < NumMeasuredFrames; ++i)
+	{
+		TickWorld();
+	}
+
+	const float MeasuredTime = NumMeasuredFrames * DeltaTime;
+
+	// a throttled brain gets the time it skipped, so its deltas add up to the time that passed
+	float FarDeltaTotal = 0.0f;
+
+	for (int32 i = FarTicksBefore; i < FarBrain->TickDeltas.Num(); ++i)
+	{
+		FarDeltaTotal += FarBrain->TickDeltas[i];
+	}
+
+	TestTrue(TEXT("Far agents should tick less often than every frame"), FarBrain->TickDeltas.Num() - FarTicksBefore < NumMeasuredFrames / 2);
+	TestNearlyEqual(TEXT("A throttled tick should receive the accumulated delta time"), FarBrain->TickDeltas.Last(), FarInterval, DeltaTime * 1.5f);
+	TestNearlyEqual(TEXT("Throttled deltas should add up to the elapsed time"), FarDeltaTotal, MeasuredTime, FarInterval + DeltaTime);
+	const int32 NumNearTicks = NearBrain->TickFrames.FilterByPredicate([FirstMeasuredFrame](const int32 TickFrame) { return TickFrame >= FirstMeasuredFrame; }).Num();
+	TestEqual(TEXT("Near agents should keep ticking every frame"), NumNearTicks, NumMeasuredFrames);
+
+	// the crowd's ticks keep the phases they got from the round-robin evaluation, so they don't bunch up
+	TArray<int32> TicksPerFrame;
+	TicksPerFrame.Init(0, NumMeasuredFrames);
+
+	for (int32 AgentIndex = 0; AgentIndex < CrowdBrains.Num(); ++AgentIndex)
+	{
+		const TArray<int32>& TickFrames = CrowdBrains[AgentIndex]->TickFrames;
+
+		for (int32 i = CrowdTicksBefore[AgentIndex]; i < TickFrames.Num(); ++i)
+		{
+			++TicksPerFrame[TickFrames[i] - FirstMeasuredFrame];
+		}
+	}
+
+	int32 MaxTicksPerFrame = 0;
+
+	for (const int32 NumTicks : TicksPerFrame)
+	{
+		MaxTicksPerFrame = FMath::Max(MaxTicksPerFrame, NumTicks);
+	}
+
+	// two slices can share a frame when the interval doesn't divide evenly into frames
+	TestTrue(TEXT("Far agent ticks should be spread over frames"), MaxTicksPerFrame <= NumPerFrame * 2);
+
+	AddInfo(FString::Printf(TEXT("%d agents: %d evaluated per frame, at most %d far ticks per frame"), NumTotalAgents, NumPerFrame, MaxTicksPerFrame));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
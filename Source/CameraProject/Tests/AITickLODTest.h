@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BrainComponent.h"
+#include "AITickLODTest.generated.h"
+
+/**
+ *  Brain component used by the AI tick LOD tests.
+ *  Records the delta time of every tick it receives, so tests can check what a throttled task would see.
+ *  Note: This is not a test itself, just a helper class for the actual tests
+ */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown)
+class UAITickLODTestBrainComponent : public UBrainComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	UAITickLODTestBrainComponent();
+
+	/** Records the tick's delta time */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Delta time of every tick received, oldest first */
+	TArray<float> TickDeltas;
+
+	/** World frame of every tick received, parallel to TickDeltas */
+	TArray<int32> TickFrames;
+
+	/** Current world frame, set by the test before each world tick */
+	int32 CurrentFrame = 0;
+};
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatEnemyPoolTest.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+ACombatEnemyPoolTestSpawner::ACombatEnemyPoolTestSpawner()
+{
+	EnemyClass = ACombatEnemyPoolTestEnemy::StaticClass();
+
+	// the test drives every spawn
+	bShouldSpawnEnemiesImmediately = false;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CombatEnemyPoolTest
+{
+	/** Number of waves spawned and removed in each mode */
+	static constexpr int32 NumWaves = 50;
+
+	/** Timings of one mode, in milliseconds */
+	struct FPoolTimings
+	{
+		double PrewarmMs = 0.0;
+		double SpawnMs = 0.0;
+		double RemoveMs = 0.0;
+	};
+
+	/** Returns the number of live test enemies, and the one that's out of the pool, if any */
+	static int32 CountEnemies(UWorld* World, ACombatEnemyPoolTestEnemy*& OutActiveEnemy)
+	{
+		int32 NumEnemies = 0;
+		OutActiveEnemy = nullptr;
+
+		for (TActorIterator<ACombatEnemyPoolTestEnemy> It(World); It; ++It)
+		{
+			++NumEnemies;
+
+			if (!It->IsInPool())
+			{
+				OutActiveEnemy = *It;
+			}
+		}
+
+		return NumEnemies;
+	}
+
+	/** Runs the waves through a spawner in a fresh world. Returns the mean timings per wave */
+	static FPoolTimings RunWaves(FAutomationTestBase& Test, const bool bPoolEnemies)
+	{
+		FPoolTimings Timings;
+
+		// headless game world with just the spawner
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, bPoolEnemies ? TEXT("CombatEnemyPoolPooled") : TEXT("CombatEnemyPoolUnpooled"));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+
+		ACombatEnemyPoolTestSpawner* Spawner = World->SpawnActor<ACombatEnemyPoolTestSpawner>();
+		Spawner->SetPoolEnemies(bPoolEnemies);
+
+		// fill the pool the way the spawn budget would once the class loads
+		if (bPoolEnemies)
+		{
+			const double PrewarmStartTime = FPlatformTime::Seconds();
+
+			for (int32 i = 0; i < Spawner->GetMaxPrewarmedEnemies(); ++i)
+			{
+				Spawner->PrewarmEnemy();
+			}
+
+			Timings.PrewarmMs = (FPlatformTime::Seconds() - PrewarmStartTime) * 1000.0 / Spawner->GetMaxPrewarmedEnemies();
+		}
+
+		const FString Mode = bPoolEnemies ? TEXT("Pooled") : TEXT("Unpooled");
+		int32 NumReused = 0;
+
+		for (int32 Wave = 0; Wave < NumWaves; ++Wave)
+		{
+			const double SpawnStartTime = FPlatformTime::Seconds();
+			Spawner->SpawnEnemy();
+			Timings.SpawnMs += (FPlatformTime::Seconds() - SpawnStartTime) * 1000.0;
+
+			ACombatEnemyPoolTestEnemy* Enemy = nullptr;
+			const int32 NumEnemies = CountEnemies(World, Enemy);
+
+			if (!Test.TestNotNull(FString::Printf(TEXT("%s wave %d should have an active enemy"), *Mode, Wave), Enemy))
+			{
+				break;
+			}
+
+			// a pooled spawner never grows past its prewarmed enemies, since each wave's enemy is back in the pool before the next
+			if (bPoolEnemies && NumEnemies == Spawner->GetMaxPrewarmedEnemies())
+			{
+				++NumReused;
+			}
+
+			const double RemoveStartTime = FPlatformTime::Seconds();
+			Enemy->Despawn();
+			Timings.RemoveMs += (FPlatformTime::Seconds() - RemoveStartTime) * 1000.0;
+		}
+
+		Timings.SpawnMs /= NumWaves;
+		Timings.RemoveMs /= NumWaves;
+
+		ACombatEnemyPoolTestEnemy* ActiveEnemy = nullptr;
+		const int32 NumLeft = CountEnemies(World, ActiveEnemy);
+
+		if (bPoolEnemies)
+		{
+			Test.TestEqual(TEXT("Every pooled wave should reuse a prewarmed enemy"), NumReused, NumWaves);
+			Test.TestEqual(TEXT("The pool should only hold the prewarmed enemies"), Spawner->GetEnemyPool().Num(), Spawner->GetMaxPrewarmedEnemies());
+			Test.TestEqual(TEXT("Pooled enemies should stay in the level"), NumLeft, Spawner->GetMaxPrewarmedEnemies());
+
+		} else {
+
+			Test.TestEqual(TEXT("Unpooled enemies should be destroyed after each wave"), NumLeft, 0);
+		}
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+
+		return Timings;
+	}
+}
+
+// Test: Spawn Versus Pool Reuse Timings
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCombatEnemyPoolTest,
+	"CameraProject.Combat.EnemyPool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FCombatEnemyPoolTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatEnemyPoolTest;
+
+	const FPoolTimings Unpooled = RunWaves(*this, false);
+	const FPoolTimings Pooled = RunWaves(*this, true);
+
+	AddInfo(FString::Printf(TEXT("Unpooled: %.3f ms per spawn, %.3f ms per destroy over %d waves"), Unpooled.SpawnMs, Unpooled.RemoveMs, NumWaves));
+	AddInfo(FString::Printf(TEXT("Pooled: %.3f ms per prewarm, %.3f ms per reuse, %.3f ms per return to pool over %d waves"), Pooled.PrewarmMs, Pooled.SpawnMs, Pooled.RemoveMs, NumWaves));
+
+	return true;
+}
+
+#endif
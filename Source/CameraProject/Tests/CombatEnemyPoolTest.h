@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Variant_Combat/AI/CombatEnemy.h"
+#include "Variant_Combat/AI/CombatEnemySpawner.h"
+#include "CombatEnemyPoolTest.generated.h"
+
+/**
+ *  Enemy spawned by the enemy pool tests. Can be removed from the level on demand, without waiting for its death timer.
+ *  Note: This is not a test itself, just a helper class for the actual tests
+ */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown)
+class ACombatEnemyPoolTestEnemy : public ACombatEnemy
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Removes this enemy from the level the way its death timer would: back to the pool if pooled, destroyed otherwise */
+	void Despawn() { RemoveFromLevel(); }
+};
+
+/**
+ *  Spawner used by the enemy pool tests. Spawns the test enemy and never spawns on its own.
+ *  Note: This is not a test itself, just a helper class for the actual tests
+ */
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown)
+class ACombatEnemyPoolTestSpawner : public ACombatEnemySpawner
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ACombatEnemyPoolTestSpawner();
+
+	/** Sets whether enemies are pooled. Call before spawning any */
+	void SetPoolEnemies(bool bPool) { bPoolEnemies = bPool; }
+
+	/** Returns the max number of enemies prewarmed into the pool */
+	int32 GetMaxPrewarmedEnemies() const { return MaxPrewarmedEnemies; }
+
+	/** Returns every enemy owned by the pool */
+	const TArray<ACombatEnemy*>& GetEnemyPool() const { return EnemyPool; }
+};
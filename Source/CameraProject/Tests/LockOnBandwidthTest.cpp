@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Editor.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "CameraProjectCharacter.h"
+#include "LockOn/CameraLockOnComponent.h"
+#include "Variant_Combat/AI/CombatEnemy.h"
+
+namespace LockOnBandwidthTest
+{
+	/** Map the session is played on */
+	static const TCHAR* MapName = TEXT("/Game/ThirdPerson/Lvl_ThirdPerson");
+
+	/** Number of targets spawned in front of the client */
+	static constexpr int32 NumTargets = 3;
+
+	/** Distance in front of the client the targets are spawned at */
+	static constexpr float TargetDistance = 600.0f;
+
+	/** Side spacing between targets */
+	static constexpr float TargetSpacing = 200.0f;
+
+	/** Length of the idle and the lock-on measurement windows */
+	static constexpr double MeasureSeconds = 5.0;
+
+	/** Time between target switches while locked on */
+	static constexpr double SwitchInterval = 0.5;
+
+	/** Max time to wait for the session to come up */
+	static constexpr double StartTimeout = 30.0;
+
+	/** State shared by the latent steps */
+	struct FSession
+	{
+		TWeakObjectPtr<UWorld> ServerWorld;
+		TWeakObjectPtr<UWorld> ClientWorld;
+		TWeakObjectPtr<ACameraProjectCharacter> ClientPawn;
+		TWeakObjectPtr<ACameraProjectCharacter> ServerCopyOfClientPawn;
+
+		double StepStartTime = 0.0;
+		double LastSwitchTime = 0.0;
+		int32 NumSwitches = 0;
+
+		int64 IdleStartBytes = 0;
+		int64 IdleBytes = 0;
+		int64 LockOnStartBytes = 0;
+		int64 LockOnBytes = 0;
+	};
+
+	/** Returns the bytes sent and received so far on the server's connection to the client */
+	static int64 GetClientConnectionBytes(const FSession& Session)
+	{
+		const UWorld* ServerWorld = Session.ServerWorld.Get();
+		const UNetDriver* NetDriver = ServerWorld ? ServerWorld->GetNetDriver() : nullptr;
+
+		if (!NetDriver || NetDriver->ClientConnections.IsEmpty())
+		{
+			return 0;
+		}
+
+		const UNetConnection* Connection = NetDriver->ClientConnections[0];
+		return static_cast<int64>(Connection->InTotalBytes) + static_cast<int64>(Connection->OutTotalBytes);
+	}
+
+	/** Finds the listen server and client worlds and the client's pawn on both. Returns true once they all exist */
+	static bool FindSession(FSession& Session)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+
+			if (Context.WorldType != EWorldType::PIE || !World)
+			{
+				continue;
+			}
+
+			if (World->GetNetMode() == NM_ListenServer)
+			{
+				Session.ServerWorld = World;
+
+			} else if (World->GetNetMode() == NM_Client) {
+
+				Session.ClientWorld = World;
+			}
+		}
+
+		if (UWorld* ClientWorld = Session.ClientWorld.Get())
+		{
+			const APlayerController* PlayerController = ClientWorld->GetFirstPlayerController();
+			Session.ClientPawn = PlayerController ? Cast<ACameraProjectCharacter>(PlayerController->GetPawn()) : nullptr;
+		}
+
+		if (UWorld* ServerWorld = Session.ServerWorld.Get())
+		{
+			// the remote player's controller is the one that isn't local on the server
+			for (FConstPlayerControllerIterator It = ServerWorld->GetPlayerControllerIterator(); It; ++It)
+			{
+				const APlayerController* PlayerController = It->Get();
+
+				if (PlayerController && !PlayerController->IsLocalController())
+				{
+					Session.ServerCopyOfClientPawn = Cast<ACameraProjectCharacter>(PlayerController->GetPawn());
+				}
+			}
+		}
+
+		return Session.ClientPawn.IsValid() && Session.ServerCopyOfClientPawn.IsValid();
+	}
+
+	/** Spawns idle targets in front of the client's pawn on the server */
+	static void SpawnTargets(const FSession& Session)
+	{
+		UWorld* ServerWorld = Session.ServerWorld.Get();
+		const ACameraProjectCharacter* Pawn = Session.ServerCopyOfClientPawn.Get();
+
+		const FVector Forward = Pawn->GetActorForwardVector();
+		const FVector Right = Pawn->GetActorRightVector();
+
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			const FVector Location = Pawn->GetActorLocation() + Forward * TargetDistance + Right * TargetSpacing * (Index - (NumTargets - 1) * 0.5f);
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+			ACombatEnemy* Target = ServerWorld->SpawnActor<ACombatEnemy>(Location, (-Forward).Rotation(), SpawnParams);
+
+			// keep the targets standing still, so their movement doesn't end up in the measurement
+			if (const AAIController* Controller = Target ? Cast<AAIController>(Target->GetController()) : nullptr)
+			{
+				if (UBrainComponent* Brain = Controller->GetBrainComponent())
+				{
+					Brain->StopLogic(TEXT("Bandwidth test"));
+				}
+			}
+		}
+	}
+}
+
+// Test: Lock-On Bandwidth Between a Listen Server and a Client
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FLockOnBandwidthTest,
+	"CameraProject.LockOn.Bandwidth",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FLockOnBandwidthTest::RunTest(const FString& Parameters)
+{
+	using namespace LockOnBandwidthTest;
+
+	FAutomationEditorCommonUtils::LoadMap(MapName);
+
+	// play as a listen server with one client, in this process
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_ListenServer);
+	PlaySettings->SetPlayNumberOfClients(2);
+	PlaySettings->SetRunUnderOneProcess(true);
+	PlaySettings->bLaunchSeparateServer = false;
+
+	FRequestPlaySessionParams PlayParams;
+	PlayParams.WorldType = EPlaySessionWorldType::PlayInEditor;
+	PlayParams.EditorPlaySettings = PlaySettings;
+
+	GEditor->RequestPlaySession(PlayParams);
+
+	const TSharedRef<FSession> Session = MakeShared<FSession>();
+	Session->StepStartTime = FPlatformTime::Seconds();
+
+	// wait for both worlds and the client's pawn, then spawn the targets
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session]()
+	{
+		if (FindSession(*Session))
+		{
+			SpawnTargets(*Session);
+			return true;
+		}
+
+		if (FPlatformTime::Seconds() - Session->StepStartTime > StartTimeout)
+		{
+			AddError(TEXT("The listen server and client session didn't start."));
+			return true;
+		}
+
+		return false;
+	}));
+
+	// let the targets replicate and settle
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(2.0f));
+
+	// measure the idle traffic first, so it can be taken out of the lock-on window
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Session]()
+	{
+		Session->IdleStartBytes = GetClientConnectionBytes(*Session);
+		Session->StepStartTime = FPlatformTime::Seconds();
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Session]()
+	{
+		if (FPlatformTime::Seconds() - Session->StepStartTime < MeasureSeconds)
+		{
+			return false;
+		}
+
+		Session->IdleBytes = GetClientConnectionBytes(*Session) - Session->IdleStartBytes;
+		return true;
+	}));
+
+	// lock on from the client and keep switching targets for the same length of time
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session]()
+	{
+		UCameraLockOnComponent* LockOn = Session->ClientPawn.IsValid() ? Session->ClientPawn->GetCameraLockOnComponent() : nullptr;
+
+		if (!LockOn)
+		{
+			AddError(TEXT("The client's pawn has no lock-on component."));
+			return true;
+		}
+
+		LockOn->ToggleLockOn();
+
+		Session->LockOnStartBytes = GetClientConnectionBytes(*Session);
+		Session->StepStartTime = FPlatformTime::Seconds();
+		Session->LastSwitchTime = Session->StepStartTime;
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Session]()
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		if (Now - Session->StepStartTime < MeasureSeconds)
+		{
+			UCameraLockOnComponent* LockOn = Session->ClientPawn.IsValid() ? Session->ClientPawn->GetCameraLockOnComponent() : nullptr;
+
+			if (LockOn && Now - Session->LastSwitchTime >= SwitchInterval)
+			{
+				LockOn->SwitchTargetRight();
+				Session->LastSwitchTime = Now;
+				++Session->NumSwitches;
+			}
+
+			return false;
+		}
+
+		Session->LockOnBytes = GetClientConnectionBytes(*Session) - Session->LockOnStartBytes;
+		return true;
+	}));
+
+	// check the lock reached the server and report the traffic it added
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session]()
+	{
+		const UCameraLockOnComponent* ClientLockOn = Session->ClientPawn.IsValid() ? Session->ClientPawn->GetCameraLockOnComponent() : nullptr;
+		const UCameraLockOnComponent* ServerLockOn = Session->ServerCopyOfClientPawn.IsValid() ? Session->ServerCopyOfClientPawn->GetCameraLockOnComponent() : nullptr;
+
+		TestTrue(TEXT("The client should be locked on"), ClientLockOn && ClientLockOn->IsLockedOn());
+		TestTrue(TEXT("The server should mirror the client's lock"), ServerLockOn && ServerLockOn->IsLockedOn());
+
+		const double IdleBytesPerSecond = Session->IdleBytes / MeasureSeconds;
+		const double LockOnBytesPerSecond = Session->LockOnBytes / MeasureSeconds;
+
+		AddInfo(FString::Printf(TEXT("Lock-on state: %.1f bytes/s over idle (%.1f bytes/s idle, %.1f bytes/s locked on, %d target switches in %.0f s)"),
+			LockOnBytesPerSecond - IdleBytesPerSecond, IdleBytesPerSecond, LockOnBytesPerSecond, Session->NumSwitches, MeasureSeconds));
+
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "LockOn/CameraLockOnComponent.h"
+#include "LockOn/LockOnTargetRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LockOnLineOfSightTest
+{
+	/** Ranked lock-on points: head, chest, capsule center */
+	static const FVector Points[] = { FVector(0.0f, 0.0f, 160.0f), FVector(0.0f, 0.0f, 120.0f), FVector(0.0f, 0.0f, 90.0f) };
+
+	/** Frame used to drive the registry's budget, far from the real frame counter */
+	static constexpr uint64 TestFrame = 1000000;
+}
+
+// Test: Lock-On Points Are Tested in Rank Order
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FLockOnSocketRankingTest,
+	"CameraProject.LockOn.SocketRanking",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FLockOnSocketRankingTest::RunTest(const FString& Parameters)
+{
+	using namespace LockOnLineOfSightTest;
+
+	auto Unlimited = []() { return true; };
+
+	// only the chest is visible: the head is tested first, then the test stops at the chest
+	{
+		TArray<FVector> Tested;
+		int32 VisibleIndex = INDEX_NONE;
+		int32 NumTraces = 0;
+
+		const ELockOnVisibility Visibility = UCameraLockOnComponent::EvaluateLockOnPoints(Points, Unlimited,
+			[&Tested](const FVector& Point) { Tested.Add(Point); return Point == Points[1]; }, &VisibleIndex, &NumTraces);
+
+		TestTrue(TEXT("A partially occluded target should be visible"), Visibility == ELockOnVisibility::Visible);
+		TestEqual(TEXT("The chest should be the visible point"), VisibleIndex, 1);
+		TestEqual(TEXT("The capsule center shouldn't be traced"), NumTraces, 2);
+		TestTrue(TEXT("The head should be tested first"), Tested.Num() > 0 && Tested[0] == Points[0]);
+	}
+
+	// the preferred point wins when everything is visible
+	{
+		int32 VisibleIndex = INDEX_NONE;
+		int32 NumTraces = 0;
+
+		UCameraLockOnComponent::EvaluateLockOnPoints(Points, Unlimited, [](const FVector&) { return true; }, &VisibleIndex, &NumTraces);
+
+		TestEqual(TEXT("The head should be picked"), VisibleIndex, 0);
+		TestEqual(TEXT("A single trace should be spent"), NumTraces, 1);
+	}
+
+	// fully occluded targets are hidden after testing every point
+	{
+		int32 NumTraces = 0;
+
+		const ELockOnVisibility Visibility = UCameraLockOnComponent::EvaluateLockOnPoints(Points, Unlimited, [](const FVector&) { return false; }, nullptr, &NumTraces);
+
+		TestTrue(TEXT("A fully occluded target should be hidden"), Visibility == ELockOnVisibility::Hidden);
+		TestEqual(TEXT("Every point should be traced"), NumTraces, static_cast<int32>(UE_ARRAY_COUNT(Points)));
+	}
+
+	return true;
+}
+
+// Test: Line of Sight Budget Is Shared and Exhausts Cleanly
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FLockOnTraceBudgetTest,
+	"CameraProject.LockOn.TraceBudget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FLockOnTraceBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace LockOnLineOfSightTest;
+
+	ULockOnTargetRegistry* Registry = NewObject<ULockOnTargetRegistry>(GetTransientPackage());
+	const int32 Budget = Registry->GetMaxLineOfSightTracesPerFrame();
+	TestTrue(TEXT("The budget should allow at least one trace"), Budget > 0);
+
+	auto ConsumeTrace = [Registry]() { return Registry->ConsumeLineOfSightTrace(TestFrame); };
+	auto Occluded = [](const FVector&) { return false; };
+
+	// the first querier spends all but one trace of the frame
+	for (int32 i = 0; i < Budget - 1; ++i)
+	{
+		Registry->ConsumeLineOfSightTrace(TestFrame);
+	}
+
+	// a second querier gets the last trace, sees the head occluded, and runs out before a conclusive result
+	int32 NumTraces = 0;
+	ELockOnVisibility Visibility = UCameraLockOnComponent::EvaluateLockOnPoints(Points, ConsumeTrace, Occluded, nullptr, &NumTraces);
+
+	TestTrue(TEXT("Running out of traces mid target should be reported as out of budget, not hidden"), Visibility == ELockOnVisibility::OutOfBudget);
+	TestEqual(TEXT("Only the remaining trace should be spent"), NumTraces, 1);
+
+	// any further querier in the same frame gets nothing
+	Visibility = UCameraLockOnComponent::EvaluateLockOnPoints(Points, ConsumeTrace, [](const FVector&) { return true; }, nullptr, &NumTraces);
+
+	TestTrue(TEXT("An exhausted budget should report out of budget"), Visibility == ELockOnVisibility::OutOfBudget);
+	TestEqual(TEXT("No trace should be spent over budget"), NumTraces, 0);
+
+	// the budget is restored on the next frame
+	TestTrue(TEXT("The budget should reset on a new frame"), Registry->ConsumeLineOfSightTrace(TestFrame + 1));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
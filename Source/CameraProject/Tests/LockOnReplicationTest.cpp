@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "LockOn/CameraLockOnComponent.h"
+#include "LockOn/LockOnTargetRegistry.h"
+
+// Test: Replicated Lock-On State Serialization Round Trip and Size
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FLockOnReplicatedStateSerializationTest,
+	"CameraProject.LockOn.ReplicatedStateSerialization",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FLockOnReplicatedStateSerializationTest::RunTest(const FString& Parameters)
+{
+	FLockOnReplicatedState Locked;
+	Locked.bLockedOn = true;
+	Locked.TargetHandle = LockOnTargetHandleMax - 1;
+	Locked.SwitchSequence = 200;
+
+	FLockOnReplicatedState Unlocked;
+	Unlocked.SwitchSequence = 201;
+
+	for (const FLockOnReplicatedState& SourceState : { Locked, Unlocked })
+	{
+		FLockOnReplicatedState State = SourceState;
+		bool bSuccess = false;
+
+		// serialize the state
+		FBitWriter Writer(64, true);
+		State.NetSerialize(Writer, nullptr, bSuccess);
+		TestTrue(TEXT("State should serialize"), bSuccess);
+
+		// it should fit in three bytes
+		const int64 NumBits = Writer.GetNumBits();
+		TestTrue(TEXT("State should fit in 24 bits"), NumBits <= 24);
+
+		// read it back
+		FBitReader Reader(Writer.GetData(), NumBits);
+		FLockOnReplicatedState ReadState;
+		ReadState.NetSerialize(Reader, nullptr, bSuccess);
+		TestTrue(TEXT("State should deserialize"), bSuccess);
+		TestTrue(TEXT("State should survive a round trip"), ReadState == State);
+
+		AddInfo(FString::Printf(TEXT("%s state: %lld serialized bits"), State.bLockedOn ? TEXT("Locked") : TEXT("Unlocked"), NumBits));
+	}
+
+	return true;
+}
@@ -0,0 +1,410 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/FloatingPawnMovement.h"
+#include "Variant_SideScrolling/SideScrollingCameraManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SideScrollingCameraBenchmark
+{
+	/** Half height of the scripted pawn, so its location sits above the ground like a capsule center */
+	static constexpr float PawnHalfHeight = 90.0f;
+
+	/** Horizontal run speed of the scripted pawn */
+	static constexpr float RunSpeed = 500.0f;
+
+	/** Gravity applied to the scripted pawn */
+	static constexpr float Gravity = -1960.0f;
+
+	/** Length of the scripted run */
+	static constexpr float Duration = 14.0f;
+
+	/** Allowed relative regression over the baseline */
+	static constexpr double JitterTolerance = 0.1;
+	static constexpr double CostTolerance = 0.5;
+
+	/** A walkable section of the test level */
+	struct FGroundSegment
+	{
+		float MinX;
+		float MaxX;
+		float TopZ;
+		bool bSoft;
+	};
+
+	/** Upper floor, a ledge down to a lower floor, and a soft platform above the lower floor */
+	static const FGroundSegment Ground[] =
+	{
+		{ -1000.0f, 2000.0f, 0.0f, false },
+		{ 2000.0f, 7000.0f, -300.0f, false },
+		{ 2600.0f, 3800.0f, -100.0f, true },
+	};
+
+	/** Scripted inputs, by time */
+	static constexpr float JumpTimes[] = { 1.0f, 5.6f };
+	static constexpr float JumpSpeeds[] = { 700.0f, 900.0f };
+	static constexpr float DropThroughTime = 7.2f;
+	static constexpr float TurnAroundTime = 11.0f;
+
+	/** Kinematic state of the scripted pawn */
+	struct FPawnState
+	{
+		FVector Location = FVector(0.0f, 0.0f, PawnHalfHeight);
+		FVector Velocity = FVector::ZeroVector;
+		bool bGrounded = true;
+		bool bDroppingThrough = false;
+	};
+
+	/** Advances the scripted path by one frame */
+	static void StepPawn(FPawnState& State, const float Time, const float DeltaTime)
+	{
+		// run right, then turn around
+		State.Velocity.X = Time < TurnAroundTime ? RunSpeed : -RunSpeed;
+
+		// jump on cue
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(JumpTimes); ++Index)
+		{
+			if (State.bGrounded && Time >= JumpTimes[Index] && Time - DeltaTime < JumpTimes[Index])
+			{
+				State.Velocity.Z = JumpSpeeds[Index];
+				State.bGrounded = false;
+			}
+		}
+
+		// drop through the soft platform on cue
+		if (State.bGrounded && Time >= DropThroughTime && Time - DeltaTime < DropThroughTime)
+		{
+			State.bDroppingThrough = true;
+			State.bGrounded = false;
+		}
+
+		const float PrevFeetZ = State.Location.Z - PawnHalfHeight;
+
+		if (!State.bGrounded)
+		{
+			State.Velocity.Z += Gravity * DeltaTime;
+		}
+
+		State.Location += State.Velocity * DeltaTime;
+
+		const float FeetZ = State.Location.Z - PawnHalfHeight;
+
+		// find the highest surface under us, landing only when coming down onto it
+		float SupportZ = -UE_BIG_NUMBER;
+
+		for (const FGroundSegment& Segment : Ground)
+		{
+			if (State.Location.X < Segment.MinX || State.Location.X > Segment.MaxX)
+			{
+				continue;
+			}
+
+			if (Segment.bSoft && State.bDroppingThrough)
+			{
+				continue;
+			}
+
+			if (PrevFeetZ >= Segment.TopZ - KINDA_SMALL_NUMBER && FeetZ <= Segment.TopZ + KINDA_SMALL_NUMBER && State.Velocity.Z <= 0.0f)
+			{
+				SupportZ = FMath::Max(SupportZ, Segment.TopZ);
+			}
+		}
+
+		if (SupportZ > -UE_BIG_NUMBER)
+		{
+			State.Location.Z = SupportZ + PawnHalfHeight;
+			State.Velocity.Z = 0.0f;
+			State.bGrounded = true;
+			State.bDroppingThrough = false;
+
+		} else {
+
+			// walked off a ledge
+			State.bGrounded = false;
+		}
+	}
+
+	/** Per frame record */
+	struct FFrameSample
+	{
+		float Time;
+		float DeltaTime;
+		FVector PawnLocation;
+		FVector CameraLocation;
+		double Jitter;
+		double Microseconds;
+	};
+
+	/** Summary compared against the baseline */
+	struct FSummary
+	{
+		double MaxJitter = 0.0;
+		double P95Jitter = 0.0;
+		double MeanMicroseconds = 0.0;
+	};
+
+	/** Returns the 95th percentile of the values */
+	static double Percentile95(TArray<double> Values)
+	{
+		if (Values.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		return Values[FMath::Min(Values.Num() - 1, FMath::FloorToInt32(Values.Num() * 0.95))];
+	}
+
+	/** Spawns the level geometry so the camera's ground traces have something to hit */
+	static void SpawnGround(UWorld* World, FAutomationTestBase& Test)
+	{
+		UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+		if (!Cube)
+		{
+			Test.AddWarning(TEXT("Couldn't load the engine cube, the benchmark runs without level geometry."));
+			return;
+		}
+
+		for (const FGroundSegment& Segment : Ground)
+		{
+			const FVector Center(0.5f * (Segment.MinX + Segment.MaxX), 0.0f, Segment.TopZ - 10.0f);
+
+			AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(Center, FRotator::ZeroRotator);
+			Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+			Floor->SetActorScale3D(FVector((Segment.MaxX - Segment.MinX) / 100.0f, 4.0f, 0.2f));
+		}
+	}
+
+	/** Runs the scripted path through the camera and records every frame */
+	static void RunScenario(UWorld* World, const bool bVariableFrameRate, TArray<FFrameSample>& OutSamples)
+	{
+		ASideScrollingCameraManager* CameraManager = World->SpawnActor<ASideScrollingCameraManager>();
+
+		// a bare pawn with a movement component, so the camera reads our scripted velocity
+		APawn* Pawn = World->SpawnActor<APawn>();
+		USceneComponent* Root = NewObject<USceneComponent>(Pawn, TEXT("Root"));
+		Pawn->SetRootComponent(Root);
+		Root->RegisterComponent();
+
+		UFloatingPawnMovement* Movement = NewObject<UFloatingPawnMovement>(Pawn, TEXT("Movement"));
+		Movement->SetUpdatedComponent(Root);
+		Movement->RegisterComponent();
+
+		FPawnState State;
+		Pawn->SetActorLocation(State.Location);
+
+		FTViewTarget ViewTarget;
+		ViewTarget.Target = Pawn;
+
+		// deterministic frame times between 144 and 20 fps
+		FRandomStream FrameTimes(1234);
+
+		float Time = 0.0f;
+
+		while (Time < Duration)
+		{
+			const float DeltaTime = bVariableFrameRate ? FrameTimes.FRandRange(1.0f / 144.0f, 1.0f / 20.0f) : 1.0f / 60.0f;
+			Time += DeltaTime;
+
+			StepPawn(State, Time, DeltaTime);
+			Pawn->SetActorLocation(State.Location);
+			Movement->Velocity = State.Velocity;
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			CameraManager->UpdateViewTargetForTesting(ViewTarget, DeltaTime);
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			FFrameSample& Sample = OutSamples.AddDefaulted_GetRef();
+			Sample.Time = Time;
+			Sample.DeltaTime = DeltaTime;
+			Sample.PawnLocation = State.Location;
+			Sample.CameraLocation = ViewTarget.POV.Location;
+			Sample.Microseconds = FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000.0;
+			Sample.Jitter = 0.0;
+
+			// second derivative of the camera position over the last three frames
+			const int32 Num = OutSamples.Num();
+
+			if (Num >= 3)
+			{
+				const FFrameSample& Prev = OutSamples[Num - 2];
+				const FFrameSample& PrevPrev = OutSamples[Num - 3];
+
+				const FVector Velocity = (Sample.CameraLocation - Prev.CameraLocation) / Sample.DeltaTime;
+				const FVector PrevVelocity = (Prev.CameraLocation - PrevPrev.CameraLocation) / Prev.DeltaTime;
+
+				Sample.Jitter = (Velocity - PrevVelocity).Size() / (0.5 * (Sample.DeltaTime + Prev.DeltaTime));
+			}
+		}
+
+		Pawn->Destroy();
+		CameraManager->Destroy();
+	}
+
+	/** Summarizes the recorded frames */
+	static FSummary Summarize(const TArray<FFrameSample>& Samples)
+	{
+		FSummary Summary;
+
+		TArray<double> Jitter;
+		double TotalMicroseconds = 0.0;
+
+		// the first frames are camera setup, not tracking
+		for (int32 Index = 3; Index < Samples.Num(); ++Index)
+		{
+			Jitter.Add(Samples[Index].Jitter);
+			Summary.MaxJitter = FMath::Max(Summary.MaxJitter, Samples[Index].Jitter);
+			TotalMicroseconds += Samples[Index].Microseconds;
+		}
+
+		Summary.P95Jitter = Percentile95(Jitter);
+		Summary.MeanMicroseconds = Jitter.Num() > 0 ? TotalMicroseconds / Jitter.Num() : 0.0;
+
+		return Summary;
+	}
+
+	/** Writes the per frame samples as CSV */
+	static void WriteSamples(const FString& FileName, const TArray<FFrameSample>& Samples)
+	{
+		FString Csv = TEXT("Time,DeltaTime,PawnX,PawnZ,CameraX,CameraY,CameraZ,Jitter,Microseconds\n");
+
+		for (const FFrameSample& Sample : Samples)
+		{
+			Csv += FString::Printf(TEXT("%.4f,%.5f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f\n"),
+				Sample.Time, Sample.DeltaTime, Sample.PawnLocation.X, Sample.PawnLocation.Z,
+				Sample.CameraLocation.X, Sample.CameraLocation.Y, Sample.CameraLocation.Z, Sample.Jitter, Sample.Microseconds);
+		}
+
+		FFileHelper::SaveStringToFile(Csv, *FileName);
+	}
+
+	/** Loads the baseline summaries, keyed by scenario name */
+	static TMap<FString, FSummary> LoadBaseline(const FString& FileName)
+	{
+		TMap<FString, FSummary> Baseline;
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FileName))
+		{
+			return Baseline;
+		}
+
+		// skip the header
+		for (int32 Index = 1; Index < Lines.Num(); ++Index)
+		{
+			// keep empty fields, so a missing cost shows up as a missing baseline instead of shifting the columns
+			TArray<FString> Fields;
+			Lines[Index].ParseIntoArray(Fields, TEXT(","), false);
+
+			if (Fields.Num() == 4)
+			{
+				FSummary& Summary = Baseline.Add(Fields[0]);
+				Summary.MaxJitter = FCString::Atod(*Fields[1]);
+				Summary.P95Jitter = FCString::Atod(*Fields[2]);
+				Summary.MeanMicroseconds = FCString::Atod(*Fields[3]);
+			}
+		}
+
+		return Baseline;
+	}
+}
+
+// Test: Side scrolling camera jitter and cost over a scripted run
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSideScrollingCameraBenchmarkTest,
+	"CameraProject.SideScrolling.CameraBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FSideScrollingCameraBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace SideScrollingCameraBenchmark;
+
+	// headless game world with just the test geometry
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SideScrollingCameraBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	SpawnGround(World, *this);
+
+	const FString OutputDir = FPaths::AutomationDir() / TEXT("SideScrollingCamera");
+	const FString BaselineFile = FPaths::ProjectDir() / TEXT("Tests/SideScrollingCameraBaseline.csv");
+	const TMap<FString, FSummary> Baseline = LoadBaseline(BaselineFile);
+
+	FString SummaryCsv = TEXT("Scenario,MaxJitter,P95Jitter,MeanMicroseconds\n");
+
+	for (const bool bVariableFrameRate : { false, true })
+	{
+		const FString Scenario = bVariableFrameRate ? TEXT("VariableFrameRate") : TEXT("FixedFrameRate");
+
+		TArray<FFrameSample> Samples;
+		RunScenario(World, bVariableFrameRate, Samples);
+		WriteSamples(OutputDir / Scenario + TEXT(".csv"), Samples);
+
+		const FSummary Summary = Summarize(Samples);
+		SummaryCsv += FString::Printf(TEXT("%s,%.3f,%.3f,%.3f\n"), *Scenario, Summary.MaxJitter, Summary.P95Jitter, Summary.MeanMicroseconds);
+
+		AddInfo(FString::Printf(TEXT("%s: %d frames, max jitter %.1f cm/s^2, p95 jitter %.1f cm/s^2, %.2f us per update"),
+			*Scenario, Samples.Num(), Summary.MaxJitter, Summary.P95Jitter, Summary.MeanMicroseconds));
+
+		// compare against the baseline. Every scenario needs one, a missing file is reported once below
+		const FSummary* Expected = Baseline.Find(Scenario);
+
+		if (!Expected && !Baseline.IsEmpty())
+		{
+			AddError(FString::Printf(TEXT("No camera baseline for %s. Record one from %s on the benchmark machine."), *Scenario, *(OutputDir / TEXT("Summary.csv"))));
+		}
+
+		if (Expected)
+		{
+			TestTrue(FString::Printf(TEXT("%s max jitter regressed (%.1f, baseline %.1f)"), *Scenario, Summary.MaxJitter, Expected->MaxJitter),
+				Summary.MaxJitter <= Expected->MaxJitter * (1.0 + JitterTolerance) + 1.0);
+
+			TestTrue(FString::Printf(TEXT("%s p95 jitter regressed (%.1f, baseline %.1f)"), *Scenario, Summary.P95Jitter, Expected->P95Jitter),
+				Summary.P95Jitter <= Expected->P95Jitter * (1.0 + JitterTolerance) + 1.0);
+
+			// the cost baseline is only meaningful on the machine that recorded it, so it's a relative gate
+			if (Expected->MeanMicroseconds > 0.0)
+			{
+				TestTrue(FString::Printf(TEXT("%s update cost regressed (%.2f us, baseline %.2f us)"), *Scenario, Summary.MeanMicroseconds, Expected->MeanMicroseconds),
+					Summary.MeanMicroseconds <= Expected->MeanMicroseconds * (1.0 + CostTolerance));
+
+			} else {
+
+				AddError(FString::Printf(TEXT("No update cost baseline for %s. Record one from %s on the benchmark machine."), *Scenario, *(OutputDir / TEXT("Summary.csv"))));
+			}
+		}
+	}
+
+	// always write the summary, so it can be promoted to the baseline
+	const FString SummaryFile = OutputDir / TEXT("Summary.csv");
+	FFileHelper::SaveStringToFile(SummaryCsv, *SummaryFile);
+
+	if (Baseline.IsEmpty())
+	{
+		AddError(FString::Printf(TEXT("No camera baseline in %s. Record one by copying %s there from a run on the benchmark machine."), *BaselineFile, *SummaryFile));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Components/BrushComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "GameFramework/Pawn.h"
+#include "Variant_SideScrolling/SideScrollingCameraManager.h"
+#include "Variant_SideScrolling/Gameplay/SideScrollingCameraBounds.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SideScrollingCameraBoundsTest
+{
+	/** Two adjacent sections of the test level */
+	static constexpr float FirstSectionMinX = 0.0f;
+	static constexpr float SectionEdgeX = 3000.0f;
+	static constexpr float SecondSectionMaxX = 8000.0f;
+
+	/** Frames to let the camera settle at each pawn location */
+	static constexpr int32 SettleFrames = 600;
+
+	/** Fixed frame time */
+	static constexpr float DeltaTime = 1.0f / 60.0f;
+
+	/** Allowed distance from the expected camera X once settled */
+	static constexpr float Tolerance = 1.0f;
+
+	/** Spawns a camera bounds volume covering the X range. The brush is a box body setup, since there's no brush builder at runtime */
+	static ASideScrollingCameraBounds* SpawnSection(UWorld* World, const float MinX, const float MaxX)
+	{
+		const FTransform Transform(FVector(0.5f * (MinX + MaxX), 0.0f, 0.0f));
+
+		// defer the spawn so the volume registers its range with the subsystem after it has a shape
+		ASideScrollingCameraBounds* Section = World->SpawnActorDeferred<ASideScrollingCameraBounds>(ASideScrollingCameraBounds::StaticClass(), Transform);
+
+		UBodySetup* BodySetup = NewObject<UBodySetup>(Section->GetBrushComponent());
+		BodySetup->AggGeom.BoxElems.Add(FKBoxElem(MaxX - MinX, 1000.0f, 10000.0f));
+		Section->GetBrushComponent()->BrushBodySetup = BodySetup;
+
+		Section->FinishSpawning(Transform);
+
+		return Section;
+	}
+
+	/** Holds the pawn at the X location until the camera settles, and returns the camera X */
+	static float SettleAt(ASideScrollingCameraManager* CameraManager, APawn* Pawn, FTViewTarget& ViewTarget, const float PawnX)
+	{
+		Pawn->SetActorLocation(FVector(PawnX, 0.0f, 0.0f));
+
+		for (int32 Frame = 0; Frame < SettleFrames; ++Frame)
+		{
+			CameraManager->UpdateViewTargetForTesting(ViewTarget, DeltaTime);
+		}
+
+		return ViewTarget.POV.Location.X;
+	}
+}
+
+// Test: The camera stops at the edge of a section, and moves on once the pawn walks into the next one
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSideScrollingCameraSectionEdgeTest,
+	"CameraProject.SideScrolling.CameraSectionEdge",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FSideScrollingCameraSectionEdgeTest::RunTest(const FString& Parameters)
+{
+	using namespace SideScrollingCameraBoundsTest;
+
+	// headless game world with two adjacent sections
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SideScrollingCameraSectionEdge"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	SpawnSection(World, FirstSectionMinX, SectionEdgeX);
+	SpawnSection(World, SectionEdgeX, SecondSectionMaxX);
+
+	ASideScrollingCameraManager* CameraManager = World->SpawnActor<ASideScrollingCameraManager>();
+
+	// a bare pawn standing still, so the camera only follows our scripted locations
+	APawn* Pawn = World->SpawnActor<APawn>();
+	USceneComponent* Root = NewObject<USceneComponent>(Pawn, TEXT("Root"));
+	Pawn->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	FTViewTarget ViewTarget;
+	ViewTarget.Target = Pawn;
+
+	// the camera keeps the edges of the view, not the pawn, inside the section
+	const float HalfViewWidth = CameraManager->CurrentZoom * FMath::Tan(FMath::DegreesToRadians(65.0f * 0.5f));
+
+	// in the middle of the first section the camera follows the pawn
+	const float MiddleX = SettleAt(CameraManager, Pawn, ViewTarget, 1500.0f);
+	TestNearlyEqual(TEXT("Camera follows the pawn inside the section"), MiddleX, 1500.0f, Tolerance);
+
+	// walking up to the section edge, the camera stops half a view short of it
+	const float EdgeX = SettleAt(CameraManager, Pawn, ViewTarget, SectionEdgeX - 50.0f);
+	TestNearlyEqual(TEXT("Camera stops at the section edge"), EdgeX, SectionEdgeX - HalfViewWidth, Tolerance);
+
+	// past the edge the pawn is in the next section, which holds the camera half a view past its start
+	const float NextX = SettleAt(CameraManager, Pawn, ViewTarget, SectionEdgeX + 50.0f);
+	TestNearlyEqual(TEXT("Camera moves into the next section"), NextX, SectionEdgeX + HalfViewWidth, Tolerance);
+
+	// further in, the camera follows the pawn again
+	const float FurtherX = SettleAt(CameraManager, Pawn, ViewTarget, 5000.0f);
+	TestNearlyEqual(TEXT("Camera follows the pawn inside the next section"), FurtherX, 5000.0f, Tolerance);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
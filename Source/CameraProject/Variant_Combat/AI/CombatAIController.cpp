@@ -3,6 +3,8 @@
 
 #include "CombatAIController.h"
 #include "Components/StateTreeAIComponent.h"
+#include "AITickLODSubsystem.h"
+#include "Engine/World.h"
 
 ACombatAIController::ACombatAIController()
 {
@@ -17,3 +19,24 @@ ACombatAIController::ACombatAIController()
 	// this is necessary for EnvQueries to work correctly
 	bAttachToPawn = true;
 }
+
+void ACombatAIController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// tick the StateTree less often when far from the player
+	if (UAITickLODSubsystem* TickLOD = GetWorld()->GetSubsystem<UAITickLODSubsystem>())
+	{
+		TickLOD->RegisterAgent(StateTreeAI);
+	}
+}
+
+void ACombatAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAITickLODSubsystem* TickLOD = GetWorld()->GetSubsystem<UAITickLODSubsystem>())
+	{
+		TickLOD->UnregisterAgent(StateTreeAI);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -24,4 +24,12 @@ public:
 
 	/** Constructor */
 	ACombatAIController();
+
+protected:
+
+	/** Registers the StateTree with the AI tick LOD */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the StateTree from the AI tick LOD */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
@@ -5,14 +5,27 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CombatAIController.h"
-#include "Components/WidgetComponent.h"
+#include "BrainComponent.h"
 #include "Engine/DamageEvents.h"
-#include "CombatLifeBar.h"
+#include "CombatLifeBarComponent.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
-
-ACombatEnemy::ACombatEnemy()
+#include "Animation/AnimMontage.h"
+#include "LockOnTargetRegistry.h"
+#include "Net/UnrealNetwork.h"
+#include "CombatMeleeSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatFactionComponent.h"
+#include "CombatAttackArcData.h"
+#include "CombatRagdollSubsystem.h"
+#include "CombatAnimationBudgetSubsystem.h"
+#include "CombatBudgetedMeshComponent.h"
+#include "AITickLODSubsystem.h"
+
+ACombatEnemy::ACombatEnemy(const FObjectInitializer& ObjectInitializer)
+	// the mesh times its own ticks for the animation budget
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCombatBudgetedMeshComponent>(ACharacter::MeshComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -29,15 +42,22 @@ ACombatEnemy::ACombatEnemy()
 	bUseControllerRotationYaw = false;
 
 	// create the life bar
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
+	LifeBar = CreateDefaultSubobject<UCombatLifeBarComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
 
+	// create the faction component
+	Faction = CreateDefaultSubobject<UCombatFactionComponent>(TEXT("Faction"));
+	Faction->SetFaction(ECombatFaction::Enemy);
+
 	// set the collision capsule size
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
 	// set the character movement properties
 	GetCharacterMovement()->bUseControllerDesiredRotation = true;
 
+	// let the animation budget throttle the mesh. This needs to be on before the mesh registers
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+
 	// reset HP to maximum
 	CurrentHP = MaxHP;
 }
@@ -125,46 +145,62 @@ float ACombatEnemy::GetLastDangerTime() const
 
 void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
-
-	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
-
 	// enemies only affect Pawn collision objects; they don't knock back boxes
 	FCollisionObjectQueryParams ObjectParams;
 	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	UCombatMeleeSubsystem* MeleeSubsystem = GetWorld()->GetSubsystem<UCombatMeleeSubsystem>();
+
+	if (!MeleeSubsystem)
+	{
+		return;
+	}
 
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	const FMaskFilter IgnoreMask = UCombatFactionComponent::GetAttackIgnoreMask(Faction->GetFaction());
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// use the baked arc for this attack window if there is one
+	if (AttackArcs)
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		const UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+		const UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+
+		if (const FCombatAttackArc* Arc = Montage ? AttackArcs->FindArc(Montage, DamageSourceBone, AnimInstance->Montage_GetPosition(Montage)) : nullptr)
 		{
-			/** does the actor have the player tag? */
-			if (CurrentHit.GetActor()->ActorHasTag(FName("Player")))
-			{
-				// check if the actor is damageable
-				ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			MeleeSubsystem->QueueArcAttack(this, *Arc, AttackArcs->GetRadius(), GetMesh()->GetComponentTransform(), ObjectParams, IgnoreMask);
+			return;
+		}
+	}
 
-				if (Damageable)
-				{
-					// knock upwards and away from the impact normal
-					const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+	// start at the provided socket location, sweep forward
+	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
+	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
 
-					// pass the damage event to the actor
-					Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+	// queue the sweep. Friendly pawns are filtered out by the query itself through the faction ignore mask,
+	// pawns without a faction are dropped in ApplyAttackHit
+	MeleeSubsystem->QueueAttack(this, TraceStart, TraceEnd, MeleeTraceRadius, ObjectParams, IgnoreMask);
+}
 
-				}
-			}
+void ACombatEnemy::ApplyAttackHit(const FHitResult& Hit)
+{
+	// only damage hostile actors. The sweep already dropped friendly factions, but shapes without a faction
+	// have an empty mask filter and pass it, so check the hit shape's mask filter for a hostile bit
+	if (!UCombatFactionComponent::IsHostileShape(Faction->GetFaction(), Hit.GetComponent()))
+	{
+		return;
+	}
+
+	// check if the actor is damageable
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Hit.GetActor());
+
+	if (Damageable)
+	{
+		// knock upwards and away from the impact normal
+		const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+
+		// queue the damage event for the actor. It's applied with the rest of the frame's damage
+		if (UCombatDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+		{
+			DamageSubsystem->QueueDamage(Hit.GetActor(), MeleeDamage, this, Hit.ImpactPoint, Impulse);
 		}
 	}
 }
@@ -210,13 +246,6 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 		// apply the knockback impulse
 		GetCharacterMovement()->AddImpulse(DamageImpulse, true);
 
-		// is the character ragdolling?
-		if (GetMesh()->IsSimulatingPhysics())
-		{
-			// apply an impulse to the ragdoll
-			GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(), DamageLocation);
-		}
-
 		// stop the attack montages to interrupt the attack
 		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 		{
@@ -224,6 +253,20 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 			AnimInstance->Montage_Stop(0.1f, ChargedAttackMontage);
 		}
 
+		// react to the hit if we survived it, keeping the pelvis vertical if it ragdolls.
+		// this goes first so a partial ragdoll started by this hit receives its impulse
+		if (CurrentHP > 0.0f)
+		{
+			HitReactions.React(this, PelvisBoneName, DamageImpulse);
+		}
+
+		// is the character ragdolling?
+		if (GetMesh()->IsSimulatingPhysics())
+		{
+			// apply an impulse to the ragdoll
+			GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(), DamageLocation);
+		}
+
 		// pass control to BP to play effects, etc.
 		ReceivedDamage(ActualDamage, DamageLocation, DamageImpulse.GetSafeNormal());
 	}
@@ -240,8 +283,20 @@ void ACombatEnemy::HandleDeath()
 	// disable character movement
 	GetCharacterMovement()->DisableMovement();
 
-	// enable full ragdoll physics
-	GetMesh()->SetSimulatePhysics(true);
+	// enable full ragdoll physics if the budget allows it, otherwise play the animated death
+	if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+	{
+		if (!RagdollSubsystem->RequestRagdoll(GetMesh(), DeathMontage == nullptr))
+		{
+			// hold the last frame instead of letting the montage blend back out to the idle pose
+			const float DeathDuration = PlayAnimMontage(DeathMontage);
+			RagdollSubsystem->FreezePoseAfter(GetMesh(), FMath::Max(0.0f, DeathDuration - DeathMontage->BlendOut.GetBlendTime()));
+		}
+
+	} else {
+
+		GetMesh()->SetSimulatePhysics(true);
+	}
 
 	// call the died delegate to notify any subscribers
 	OnEnemyDied.Broadcast();
@@ -257,8 +312,8 @@ void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
 
 void ACombatEnemy::NotifyDanger(const FVector& DangerLocation, AActor* DangerSource)
 {
-	// ensure we're being attacked by the player
-	if (DangerSource && DangerSource->ActorHasTag(FName("Player")))
+	// ensure we're being attacked by a hostile faction
+	if (UCombatFactionComponent::IsHostileTo(Faction->GetFaction(), DangerSource))
 	{
 		// save the danger location and game time
 		LastDangerLocation = DangerLocation;
@@ -268,8 +323,113 @@ void ACombatEnemy::NotifyDanger(const FVector& DangerLocation, AActor* DangerSou
 
 void ACombatEnemy::RemoveFromLevel()
 {
-	// destroy this actor
-	Destroy();
+	// pooled enemies go back to their spawner to be reused
+	if (bIsPooled)
+	{
+		ReturnToPool();
+
+	} else {
+
+		// destroy this actor
+		Destroy();
+	}
+}
+
+void ACombatEnemy::ReturnToPool()
+{
+	bIsInPool = true;
+
+	// stay invalid for lock-on while pooled
+	CurrentHP = 0.0f;
+
+	// clear the death timer in case we're returned early
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// stop the StateTree
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Pooled"));
+		}
+	}
+
+	// stop the animation, ragdoll and movement
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+
+	if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+	{
+		RagdollSubsystem->ReleaseRagdoll(GetMesh());
+
+	} else {
+
+		GetMesh()->SetSimulatePhysics(false);
+		GetMesh()->SetPhysicsBlendWeight(0.0f);
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	// hide and go dormant
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	GetMesh()->SetComponentTickEnabled(false);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+}
+
+void ACombatEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	bIsInPool = false;
+
+	const ACombatEnemy* Defaults = GetClass()->GetDefaultObject<ACombatEnemy>();
+
+	// restore collision first, so the teleport can find a free spot
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+	SetActorEnableCollision(true);
+
+	if (!TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator()))
+	{
+		SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	}
+
+	// put the mesh back on the capsule after the death ragdoll
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeLocationAndRotation(Defaults->GetMesh()->GetRelativeLocation(), Defaults->GetMesh()->GetRelativeRotation());
+
+	// reset the combat state
+	CurrentHP = MaxHP;
+	bIsAttacking = false;
+	CurrentComboAttack = 0;
+	CurrentChargeLoop = 0;
+	LastDangerLocation = FVector::ZeroVector;
+	LastDangerTime = -1000.0f;
+
+	// reset the life bar
+	LifeBar->SetHiddenInGame(false);
+	LifeBar->SetLifePercentage(1.0f);
+
+	// show and wake up
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	// restart the StateTree now that the HP is topped up
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
 }
 
 float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -283,6 +443,15 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	// reduce the current HP
 	CurrentHP -= Damage;
 
+	// react right away, even if the StateTree was ticking at a low rate
+	if (const AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UAITickLODSubsystem* TickLOD = GetWorld()->GetSubsystem<UAITickLODSubsystem>())
+		{
+			TickLOD->WakeAgent(AIController->GetBrainComponent());
+		}
+	}
+
 	// have we run out of HP?
 	if (CurrentHP <= 0.0f)
 	{
@@ -292,11 +461,7 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
-
-		// enable partial ragdoll physics, but keep the pelvis vertical
-		GetMesh()->SetPhysicsBlendWeight(0.5f);
-		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		LifeBar->SetLifePercentage(CurrentHP / MaxHP);
 	}
 
 	// return the received damage amount
@@ -311,7 +476,10 @@ void ACombatEnemy::Landed(const FHitResult& Hit)
 	if (CurrentHP >= 0.0f)
 	{
 		// disable ragdoll physics
-		GetMesh()->SetPhysicsBlendWeight(0.0f);
+		if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+		{
+			RagdollSubsystem->EndPartialRagdoll(GetMesh());
+		}
 	}
 
 	// call the landed Delegate for StateTree
@@ -326,22 +494,69 @@ void ACombatEnemy::BeginPlay()
 	// we top the HP before BeginPlay so StateTree picks it up at the right value
 	Super::BeginPlay();
 
-	// get the life bar widget from the widget comp
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
-
 	// fill the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	LifeBar->SetLifePercentage(1.0f);
+
+	// let the animation budget pick the mesh's update rate
+	if (UCombatAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UCombatAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->RegisterMesh(GetMesh());
+	}
+
+	// register as a lock-on target. The server assigns the handle, clients wait for it to replicate
+	if (HasAuthority())
+	{
+		if (ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>())
+		{
+			LockOnHandle = Registry->RegisterTarget(this);
+		}
+	}
+	else
+	{
+		OnRep_LockOnHandle();
+	}
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// release the lock-on handle
+	if (ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>())
+	{
+		Registry->UnregisterTarget(this);
+	}
+
+	// stop budgeting the mesh
+	if (UCombatAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UCombatAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->UnregisterMesh(GetMesh());
+	}
+
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
 }
 
+void ACombatEnemy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// the handle never changes after spawn
+	DOREPLIFETIME_CONDITION(ACombatEnemy, LockOnHandle, COND_InitialOnly);
+}
+
+void ACombatEnemy::OnRep_LockOnHandle()
+{
+	// map the server-assigned handle to this enemy
+	if (LockOnHandle != 0)
+	{
+		if (ULockOnTargetRegistry* Registry = GetWorld()->GetSubsystem<ULockOnTargetRegistry>())
+		{
+			Registry->RegisterTargetWithHandle(this, LockOnHandle);
+		}
+	}
+}
+
 FVector ACombatEnemy::GetLockOnLocation() const
 {
 	// Return the center of the character's capsule (torso level)
@@ -357,6 +572,25 @@ FVector ACombatEnemy::GetLockOnLocation() const
 	return Location;
 }
 
+void ACombatEnemy::GetLockOnLocations(TArray<FVector>& OutLocations) const
+{
+	// add the configured sockets first, in preference order
+	if (const USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		for (const FName& SocketName : LockOnSocketNames)
+		{
+			// skip sockets missing from the current mesh
+			if (MeshComp->DoesSocketExist(SocketName))
+			{
+				OutLocations.Add(MeshComp->GetSocketLocation(SocketName));
+			}
+		}
+	}
+
+	// always fall back to the center of the capsule
+	OutLocations.Add(GetLockOnLocation());
+}
+
 bool ACombatEnemy::IsLockOnValid() const
 {
 	// Enemy is valid for lock-on if it's alive
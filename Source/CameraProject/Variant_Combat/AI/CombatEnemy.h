@@ -6,13 +6,15 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatHitReactions.h"
 #include "Animation/AnimMontage.h"
 #include "Engine/TimerHandle.h"
 #include "ILockOnTarget.h"
 #include "CombatEnemy.generated.h"
 
-class UWidgetComponent;
-class UCombatLifeBar;
+class UCombatLifeBarComponent;
+class UCombatFactionComponent;
+class UCombatAttackArcData;
 class UAnimMontage;
 
 /** Completed attack animation delegate for StateTree */
@@ -33,14 +35,18 @@ class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDa
 {
 	GENERATED_BODY()
 
-	/** Life bar widget component */
+	/** Life bar component */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
+	UCombatLifeBarComponent* LifeBar;
+
+	/** Combat faction component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatFactionComponent* Faction;
 
 public:
 	
 	/** Constructor */
-	ACombatEnemy();
+	ACombatEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -60,9 +66,21 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
+	/** How non-lethal hits are reacted to */
 	UPROPERTY(EditAnywhere, Category="Damage")
-	UCombatLifeBar* LifeBarWidget;
+	FCombatHitReactions HitReactions;
+
+	/** Mesh sockets or bones the camera lock-on may target, ranked by preference. The capsule center is always tested last */
+	UPROPERTY(EditAnywhere, Category="Lock On")
+	TArray<FName> LockOnSocketNames;
+
+	/** Compact lock-on handle assigned by the server, so replicated lock-on state can reference this enemy */
+	UPROPERTY(ReplicatedUsing=OnRep_LockOnHandle)
+	uint16 LockOnHandle = 0;
+
+	/** Registers the replicated lock-on handle on clients */
+	UFUNCTION()
+	void OnRep_LockOnHandle();
 
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
@@ -75,6 +93,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
 	float MeleeTraceRadius = 50.0f;
 
+	/** Optional baked attack arcs. Attacks with a baked arc query the arc instead of sweeping a sphere forward */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace")
+	UCombatAttackArcData* AttackArcs;
+
 	/** Amount of damage a melee attack will deal */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 100))
 	float MeleeDamage = 1.0f;
@@ -127,6 +149,13 @@ protected:
 	/** Number of charge animation loop currently playing */
 	int32 CurrentChargeLoop = 0;
 
+	/**
+	 *  Death animation played when the ragdoll budget is full. The mesh is frozen on its last frame before it blends out.
+	 *  Unset by default, in which case the enemy always ragdolls and the oldest simulating ragdoll is put to sleep to keep the budget
+	 */
+	UPROPERTY(EditAnywhere, Category="Death")
+	UAnimMontage* DeathMontage;
+
 	/** Time to wait before removing this character from the level after it dies */
 	UPROPERTY(EditAnywhere, Category="Death")
 	float DeathRemovalTime = 5.0f;
@@ -143,6 +172,12 @@ protected:
 	/** Last recorded game time we were attacked */
 	float LastDangerTime = -1000.0f;
 
+	/** If true, this enemy belongs to a spawner's pool and is returned to it instead of destroyed */
+	bool bIsPooled = false;
+
+	/** If true, this enemy is hidden and dormant, waiting in its spawner's pool */
+	bool bIsInPool = false;
+
 public:
 	/** Attack completed internal delegate to notify StateTree tasks */
 	FOnEnemyAttackCompleted OnAttackCompleted;
@@ -178,6 +213,9 @@ public:
 	/** Performs an attack's collision check */
 	virtual void DoAttackTrace(FName DamageSourceBone) override;
 
+	/** Applies a resolved hit from the attack trace. Only actors with a hostile faction are damaged */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	/** Performs a combo attack's check to continue the string */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckCombo() override;
@@ -209,6 +247,9 @@ public:
 	/** Returns the world location where the camera should lock on (center of torso) */
 	virtual FVector GetLockOnLocation() const override;
 
+	/** Returns the lock-on sockets in preference order, followed by the center of torso */
+	virtual void GetLockOnLocations(TArray<FVector>& OutLocations) const override;
+
 	/** Returns true if this enemy is alive and valid for lock-on */
 	virtual bool IsLockOnValid() const override;
 
@@ -222,6 +263,20 @@ protected:
 	/** Removes this character from the level after it dies */
 	void RemoveFromLevel();
 
+public:
+
+	/** Flags this enemy as owned by a spawner's pool */
+	void SetPooled(bool bPooled) { bIsPooled = bPooled; }
+
+	/** Returns true if this enemy is waiting in its spawner's pool */
+	bool IsInPool() const { return bIsInPool; }
+
+	/** Hides this enemy and stops its physics, movement and StateTree until it's reused */
+	void ReturnToPool();
+
+	/** Places a pooled enemy and resets it to its freshly spawned state */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
 public:
 
 	/** Overrides the default TakeDamage functionality */
@@ -243,4 +298,9 @@ protected:
 
 	/** EndPlay cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Sets up replicated properties */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 };
@@ -8,6 +8,16 @@
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatSpawnBudgetSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "HAL/PlatformTime.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Spawn"), STAT_CombatEnemySpawn, STATGROUP_CameraProject);
+DECLARE_CYCLE_STAT(TEXT("Enemy Pool Reuse"), STAT_CombatEnemyPoolReuse, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Enemies"), STAT_CombatPooledEnemies, STATGROUP_CameraProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Enemy Class Load Time (ms)"), STAT_CombatEnemyClassLoadTime, STATGROUP_CameraProject);
+DECLARE_CYCLE_STAT(TEXT("Enemy Class Blocking Load"), STAT_CombatEnemyClassBlockingLoad, STATGROUP_CameraProject);
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -31,12 +41,15 @@ ACombatEnemySpawner::ACombatEnemySpawner()
 void ACombatEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
+		// start loading the enemy class during the initial delay
+		RequestEnemyClassLoad();
+
 		// schedule the first enemy spawn
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::QueueSpawn, InitialSpawnDelay);
 	}
 
 }
@@ -45,26 +58,196 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the spawn timer
+	// clear the spawn timer and any queued spawns
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	if (UCombatSpawnBudgetSubsystem* SpawnBudget = GetWorld()->GetSubsystem<UCombatSpawnBudgetSubsystem>())
+	{
+		SpawnBudget->CancelSpawns(this);
+	}
+
+	// drop the enemy class load
+	if (EnemyClassHandle.IsValid())
+	{
+		EnemyClassHandle->CancelHandle();
+		EnemyClassHandle.Reset();
+	}
+
+	// destroy the enemies still waiting in the pool
+	for (ACombatEnemy* Enemy : EnemyPool)
+	{
+		if (IsValid(Enemy) && Enemy->IsInPool())
+		{
+			Enemy->Destroy();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_CombatPooledEnemies, EnemyPool.Num());
+	EnemyPool.Reset();
 }
 
 void ACombatEnemySpawner::SpawnEnemy()
 {
-	// ensure the enemy class is valid
-	if (IsValid(EnemyClass))
+	// ensure the enemy class is valid. This only blocks if the async load hasn't finished yet
+	UClass* LoadedEnemyClass = GetLoadedEnemyClass();
+
+	if (!LoadedEnemyClass)
+	{
+		return;
+	}
+
+	// reuse a pooled enemy if one is waiting
+	if (bPoolEnemies)
+	{
+		for (ACombatEnemy* Enemy : EnemyPool)
+		{
+			if (IsValid(Enemy) && Enemy->IsInPool())
+			{
+				SCOPE_CYCLE_COUNTER(STAT_CombatEnemyPoolReuse);
+
+				Enemy->ActivateFromPool(SpawnCapsule->GetComponentTransform());
+				return;
+			}
+		}
+	}
+
+	// nothing to reuse, spawn a new one
+	CreateEnemy(LoadedEnemyClass);
+}
+
+void ACombatEnemySpawner::PrewarmEnemy()
+{
+	// the class may have been dropped since the prewarm was queued, and wave spawns that ran first may have filled the pool already
+	UClass* LoadedEnemyClass = EnemyClass.Get();
+
+	if (!LoadedEnemyClass || !bPoolEnemies || EnemyPool.Num() >= MaxPrewarmedEnemies)
+	{
+		return;
+	}
+
+	if (ACombatEnemy* Enemy = CreateEnemy(LoadedEnemyClass))
+	{
+		Enemy->ReturnToPool();
+	}
+}
+
+void ACombatEnemySpawner::QueueSpawn()
+{
+	// spawn through the budget, so spawners firing on the same frame don't stack their spawns
+	if (UCombatSpawnBudgetSubsystem* SpawnBudget = GetWorld()->GetSubsystem<UCombatSpawnBudgetSubsystem>())
+	{
+		SpawnBudget->RequestSpawn(this);
+
+	} else {
+
+		SpawnEnemy();
+	}
+}
+
+ACombatEnemy* ACombatEnemySpawner::CreateEnemy(UClass* LoadedEnemyClass)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatEnemySpawn);
+
+	// spawn the enemy at the reference capsule's transform
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(LoadedEnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+
+	// was the enemy successfully created?
+	if (SpawnedEnemy)
+	{
+		// subscribe to the death delegate
+		SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+
+		// keep pooled enemies around after death
+		if (bPoolEnemies)
+		{
+			SpawnedEnemy->SetPooled(true);
+			EnemyPool.Add(SpawnedEnemy);
+
+			INC_DWORD_STAT(STAT_CombatPooledEnemies);
+		}
+	}
+
+	return SpawnedEnemy;
+}
+
+void ACombatEnemySpawner::RequestEnemyClassLoad()
+{
+	if (EnemyClass.IsNull() || EnemyClassHandle.IsValid())
+	{
+		return;
+	}
+
+	EnemyClassLoadStartTime = FPlatformTime::Seconds();
+
+	// the delegate also fires right away if the class is already in memory
+	EnemyClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(EnemyClass.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ACombatEnemySpawner::OnEnemyClassLoaded));
+}
+
+UClass* ACombatEnemySpawner::GetLoadedEnemyClass()
+{
+	if (UClass* LoadedClass = EnemyClass.Get())
+	{
+		return LoadedClass;
+	}
+
+	if (EnemyClass.IsNull())
+	{
+		return nullptr;
+	}
+
+	// the class isn't ready. Block on the load, since the spawn can't wait
+	SCOPE_CYCLE_COUNTER(STAT_CombatEnemyClassBlockingLoad);
+
+	const double BlockStartTime = FPlatformTime::Seconds();
+
+	RequestEnemyClassLoad();
+
+	if (EnemyClassHandle.IsValid())
+	{
+		EnemyClassHandle->WaitUntilComplete();
+	}
+
+	UE_LOG(LogCameraProject, Warning, TEXT("%s blocked for %.2f ms loading %s"), *GetName(), (FPlatformTime::Seconds() - BlockStartTime) * 1000.0, *EnemyClass.ToString());
+
+	return EnemyClass.Get();
+}
+
+void ACombatEnemySpawner::OnEnemyClassLoaded()
+{
+	UClass* LoadedClass = EnemyClass.Get();
+
+	if (!LoadedClass)
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		UE_LOG(LogCameraProject, Warning, TEXT("%s failed to load %s"), *GetName(), *EnemyClass.ToString());
+		return;
+	}
+
+	// report the load timing
+	const double LoadTimeMs = (FPlatformTime::Seconds() - EnemyClassLoadStartTime) * 1000.0;
+	SET_FLOAT_STAT(STAT_CombatEnemyClassLoadTime, LoadTimeMs);
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+	UE_LOG(LogCameraProject, Log, TEXT("%s loaded %s in %.2f ms"), *GetName(), *LoadedClass->GetName(), LoadTimeMs);
 
-		// was the enemy successfully created?
-		if (SpawnedEnemy)
+	// fill the pool now that the class is in memory, so waves don't pay for actor, controller, StateTree and widget creation.
+	// each prewarm is a full spawn, so they go through the budget like any other
+	if (bPoolEnemies && EnemyPool.IsEmpty())
+	{
+		const int32 PrewarmCount = FMath::Min(SpawnCount, MaxPrewarmedEnemies);
+		UCombatSpawnBudgetSubsystem* SpawnBudget = GetWorld()->GetSubsystem<UCombatSpawnBudgetSubsystem>();
+
+		for (int32 i = 0; i < PrewarmCount; ++i)
 		{
-			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			if (SpawnBudget)
+			{
+				SpawnBudget->RequestSpawn(this, true);
+
+			} else {
+
+				PrewarmEnemy();
+			}
 		}
 	}
 }
@@ -83,7 +266,7 @@ void ACombatEnemySpawner::OnEnemyDied()
 	}
 
 	// schedule the next enemy spawn
-	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::QueueSpawn, RespawnDelay);
 }
 
 void ACombatEnemySpawner::SpawnerDepleted()
@@ -117,10 +300,19 @@ void ACombatEnemySpawner::ActivateInteraction(AActor* ActivationInstigator)
 	bHasBeenActivated = true;
 
 	// spawn the first enemy
-	SpawnEnemy();
+	QueueSpawn();
 }
 
 void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
 {
 	// stub
 }
+
+void ACombatEnemySpawner::PrepareInteraction(AActor* ActivationInstigator)
+{
+	// only deferred spawners load on approach. Immediate ones started loading on BeginPlay
+	if (!bShouldSpawnEnemiesImmediately)
+	{
+		RequestEnemyClassLoad();
+	}
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "Engine/StreamableManager.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
@@ -14,6 +15,7 @@ class ACombatEnemy;
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
  *  Enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
+ *  Enemies can be pooled: they are spawned hidden on BeginPlay and reset for each wave instead of being destroyed after death.
  *  The spawner can be remotely activated through the ICombatActivatable interface
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
  */
@@ -30,9 +32,15 @@ class ACombatEnemySpawner : public AActor, public ICombatActivatable
 
 protected:
 
-	/** Type of enemy to spawn */
+	/** Type of enemy to spawn. Loaded asynchronously on level start or when a nearby activation volume is approached */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
-	TSubclassOf<ACombatEnemy> EnemyClass;
+	TSoftClassPtr<ACombatEnemy> EnemyClass;
+
+	/** Streamable handle for the in-flight or completed enemy class load */
+	TSharedPtr<FStreamableHandle> EnemyClassHandle;
+
+	/** Time the enemy class load was requested */
+	double EnemyClassLoadStartTime = 0.0;
 
 	/** If true, the first enemy will be spawned as soon as the game starts */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
@@ -50,6 +58,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
 
+	/** If true, enemies are spawned up front and reused after death instead of being spawned and destroyed for each wave */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Pool")
+	bool bPoolEnemies = true;
+
+	/** Max number of enemies spawned up front, through the spawn budget. Enemies come back to the pool after death, so the pool only grows if it runs dry */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner|Pool", meta = (ClampMin = 1, ClampMax = 100, EditCondition = "bPoolEnemies"))
+	int32 MaxPrewarmedEnemies = 2;
+
+	/** Every enemy owned by this spawner's pool, active or not */
+	UPROPERTY()
+	TArray<ACombatEnemy*> EnemyPool;
+
 	/** Time to wait after this spawner is depleted before activating the actor list */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
 	float ActivationDelay = 1.0f;
@@ -77,11 +97,31 @@ public:
 	/** Cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
-protected:
+public:
 
-	/** Spawn an enemy and subscribe to its death event */
+	/** Spawn an enemy, or reuse one from the pool. Called by the spawn budget subsystem once the request fits in a frame */
 	void SpawnEnemy();
 
+	/** Spawn an enemy straight into the pool. Called by the spawn budget subsystem for prewarm requests */
+	void PrewarmEnemy();
+
+protected:
+
+	/** Queues an enemy spawn with the spawn budget subsystem */
+	void QueueSpawn();
+
+	/** Spawns a new enemy, subscribes to its death event and adds it to the pool if pooling */
+	ACombatEnemy* CreateEnemy(UClass* LoadedEnemyClass);
+
+	/** Starts loading the enemy class, if it isn't loaded or loading already */
+	void RequestEnemyClassLoad();
+
+	/** Returns the enemy class, blocking on the load if it isn't ready yet */
+	UClass* GetLoadedEnemyClass();
+
+	/** Called when the enemy class finishes loading. Reports the timing and fills the pool */
+	void OnEnemyClassLoaded();
+
 	/** Called when the spawned enemy has died */
 	UFUNCTION()
 	void OnEnemyDied();
@@ -105,5 +145,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Activatable")
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) override;
 
+	/** Starts loading the enemy class ahead of activation */
+	virtual void PrepareInteraction(AActor* ActivationInstigator) override;
+
 	// ~end IActivatable interface
 };
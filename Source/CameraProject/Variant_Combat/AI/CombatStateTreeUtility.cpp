@@ -9,7 +9,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
 #include "CombatEnemy.h"
-#include "Kismet/GameplayStatics.h"
+#include "AIPlayerInfoSubsystem.h"
 #include "StateTreeAsyncExecutionContext.h"
 
 bool FStateTreeCharacterGroundedCondition::TestCondition(FStateTreeExecutionContext& Context) const
@@ -301,14 +301,21 @@ EStateTreeRunStatus FStateTreeGetPlayerInfoTask::Tick(FStateTreeExecutionContext
 	// get the instance data
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-	// get the character possessed by the first local player
-	InstanceData.TargetPlayerCharacter = Cast<ACharacter>(UGameplayStatics::GetPlayerPawn(InstanceData.Character, 0));
+	// get the closest player from the per-frame player cache
+	const FAIPlayerInfo* Player = nullptr;
+
+	if (UAIPlayerInfoSubsystem* PlayerInfo = InstanceData.Character->GetWorld()->GetSubsystem<UAIPlayerInfoSubsystem>())
+	{
+		Player = PlayerInfo->FindClosestPlayer(InstanceData.Character->GetActorLocation());
+	}
+
+	InstanceData.TargetPlayerCharacter = Player ? Cast<ACharacter>(Player->Pawn.Get()) : nullptr;
 
 	// do we have a valid target?
 	if (InstanceData.TargetPlayerCharacter)
 	{
 		// update the last known location
-		InstanceData.TargetPlayerLocation = InstanceData.TargetPlayerCharacter->GetActorLocation();
+		InstanceData.TargetPlayerLocation = Player->Location;
 	}
 
 	// update the distance
@@ -2,17 +2,26 @@
 
 
 #include "EnvQueryContext_Player.h"
-#include "Kismet/GameplayStatics.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "AIPlayerInfoSubsystem.h"
 
 void UEnvQueryContext_Player::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
-	// get the player pawn for the first local player
-	AActor* PlayerPawn = UGameplayStatics::GetPlayerPawn(QueryInstance.Owner.Get(), 0);
-	check(PlayerPawn);
+	const AActor* QueryOwner = Cast<AActor>(QueryInstance.Owner.Get());
+	UAIPlayerInfoSubsystem* PlayerInfo = QueryOwner ? QueryOwner->GetWorld()->GetSubsystem<UAIPlayerInfoSubsystem>() : nullptr;
 
-	// add the actor data to the context
-	UEnvQueryItemType_Actor::SetContextHelper(ContextData, PlayerPawn);
+	if (!PlayerInfo)
+	{
+		return;
+	}
+
+	// get the player pawn closest to the querier from the per-frame player cache
+	if (const FAIPlayerInfo* Player = PlayerInfo->FindClosestPlayer(QueryOwner->GetActorLocation()))
+	{
+		// add the actor data to the context
+		UEnvQueryItemType_Actor::SetContextHelper(ContextData, Player->Pawn.Get());
+	}
 }
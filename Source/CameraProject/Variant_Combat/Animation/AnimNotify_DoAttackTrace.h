@@ -7,7 +7,8 @@
 #include "AnimNotify_DoAttackTrace.generated.h"
 
 /**
- *  AnimNotify to tell the actor to perform an attack trace check to look for targets to damage.
+ *  AnimNotify to tell the actor to queue an attack trace check to look for targets to damage.
+ *  The trace is resolved with the rest of the frame's attacks by the melee subsystem, after animation.
  */
 UCLASS()
 class UAnimNotify_DoAttackTrace : public UAnimNotify
@@ -27,4 +28,7 @@ public:
 
 	/** Get the notify name */
 	virtual FString GetNotifyName_Implementation() const override;
+
+	/** Returns the source bone for the attack trace */
+	FName GetAttackBoneName() const { return AttackBoneName; }
 };
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatAttackArcData.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AnimNotify_DoAttackTrace.h"
+#include "CameraProject.h"
+
+/** How far past its trigger time an attack notify may be dispatched and still match its arc */
+static constexpr float MaxNotifyLag = 0.1f;
+
+void UCombatAttackArcData::BakeArcs()
+{
+#if WITH_EDITOR
+
+	Arcs.Reset();
+
+	// keep consecutive points within half a radius so the spheres along the arc overlap
+	const float MaxSpacing = Radius * 0.5f;
+
+	for (UAnimMontage* Montage : Montages)
+	{
+		if (!Montage || !Montage->GetSkeleton())
+		{
+			continue;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = Montage->GetSkeleton()->GetReferenceSkeleton();
+
+		for (const FAnimNotifyEvent& NotifyEvent : Montage->Notifies)
+		{
+			const UAnimNotify_DoAttackTrace* AttackNotify = Cast<UAnimNotify_DoAttackTrace>(NotifyEvent.Notify);
+
+			if (!AttackNotify)
+			{
+				continue;
+			}
+
+			const int32 BoneIndex = RefSkeleton.FindBoneIndex(AttackNotify->GetAttackBoneName());
+
+			if (BoneIndex == INDEX_NONE)
+			{
+				UE_LOG(LogCameraProject, Warning, TEXT("Attack arc bake: bone %s not found in %s"), *AttackNotify->GetAttackBoneName().ToString(), *Montage->GetName());
+				continue;
+			}
+
+			FCombatAttackArc Arc;
+			Arc.Montage = Montage;
+			Arc.BoneName = AttackNotify->GetAttackBoneName();
+			Arc.NotifyTime = NotifyEvent.GetTriggerTime();
+
+			// the window leads up to the notify, but never reaches back into the previous section
+			const int32 SectionIndex = Montage->GetSectionIndexFromPosition(Arc.NotifyTime);
+			const float SectionStart = SectionIndex != INDEX_NONE ? Montage->GetAnimCompositeSection(SectionIndex).GetTime() : 0.0f;
+			const float WindowStart = FMath::Max(SectionStart, Arc.NotifyTime - WindowDuration);
+
+			const int32 NumSamples = FMath::Max(1, FMath::CeilToInt((Arc.NotifyTime - WindowStart) * SampleRate));
+
+			for (int32 Sample = 0; Sample <= NumSamples; ++Sample)
+			{
+				FVector Location;
+
+				if (!SampleBoneLocation(Montage, BoneIndex, FMath::Lerp(WindowStart, Arc.NotifyTime, static_cast<float>(Sample) / NumSamples), Location))
+				{
+					continue;
+				}
+
+				// fill in fast movement between samples
+				if (!Arc.Points.IsEmpty())
+				{
+					const FVector Previous = Arc.Points.Last();
+					const int32 Steps = FMath::CeilToInt(FVector::Dist(Previous, Location) / MaxSpacing);
+
+					for (int32 Step = 1; Step < Steps; ++Step)
+					{
+						Arc.Points.Add(FMath::Lerp(Previous, Location, static_cast<float>(Step) / Steps));
+					}
+				}
+
+				Arc.Points.Add(Location);
+			}
+
+			if (Arc.Points.IsEmpty())
+			{
+				UE_LOG(LogCameraProject, Warning, TEXT("Attack arc bake: no animation to sample at %.2fs in %s"), Arc.NotifyTime, *Montage->GetName());
+				continue;
+			}
+
+			Arc.Bounds = FBox(Arc.Points).ExpandBy(Radius);
+
+			Arcs.Add(MoveTemp(Arc));
+		}
+	}
+
+	// sort by notify time so lookups can stop at the montage position
+	Arcs.StableSort([](const FCombatAttackArc& A, const FCombatAttackArc& B) { return A.NotifyTime < B.NotifyTime; });
+
+	int32 NumPoints = 0;
+
+	for (const FCombatAttackArc& Arc : Arcs)
+	{
+		NumPoints += Arc.Points.Num();
+	}
+
+	UE_LOG(LogCameraProject, Log, TEXT("Attack arc bake: %d arcs, %d points"), Arcs.Num(), NumPoints);
+
+	MarkPackageDirty();
+
+#endif
+}
+
+const FCombatAttackArc* UCombatAttackArcData::FindArc(const UAnimMontage* Montage, const FName BoneName, const float MontagePosition) const
+{
+	const FCombatAttackArc* FoundArc = nullptr;
+
+	for (const FCombatAttackArc& Arc : Arcs)
+	{
+		// notifies are dispatched at or after their trigger time, so later arcs can't match
+		if (Arc.NotifyTime > MontagePosition + UE_KINDA_SMALL_NUMBER)
+		{
+			break;
+		}
+
+		if (Arc.Montage == Montage && Arc.BoneName == BoneName && MontagePosition - Arc.NotifyTime <= MaxNotifyLag)
+		{
+			FoundArc = &Arc;
+		}
+	}
+
+	return FoundArc;
+}
+
+#if WITH_EDITOR
+
+bool UCombatAttackArcData::SampleBoneLocation(const UAnimMontage* Montage, const int32 BoneIndex, const float MontagePosition, FVector& OutLocation)
+{
+	if (Montage->SlotAnimTracks.IsEmpty())
+	{
+		return false;
+	}
+
+	// find the sequence playing on the first slot at this position
+	const FAnimSegment* Segment = Montage->SlotAnimTracks[0].AnimTrack.GetSegmentAtTime(MontagePosition);
+	const UAnimSequence* Sequence = Segment ? Cast<UAnimSequence>(Segment->GetAnimReference()) : nullptr;
+
+	if (!Sequence)
+	{
+		return false;
+	}
+
+	const FAnimExtractContext ExtractContext(static_cast<double>(Segment->ConvertTrackPosToAnimPos(MontagePosition)));
+	const FReferenceSkeleton& RefSkeleton = Montage->GetSkeleton()->GetReferenceSkeleton();
+
+	// accumulate local transforms up to the root. The root keeps its reference pose, since root motion moves the actor and not the mesh
+	FTransform ComponentTransform = FTransform::Identity;
+
+	for (int32 Index = BoneIndex; Index != INDEX_NONE; Index = RefSkeleton.GetParentIndex(Index))
+	{
+		FTransform LocalTransform = RefSkeleton.GetRefBonePose()[Index];
+
+		if (RefSkeleton.GetParentIndex(Index) != INDEX_NONE)
+		{
+			Sequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(Index), ExtractContext, false);
+		}
+
+		ComponentTransform = ComponentTransform * LocalTransform;
+	}
+
+	OutLocation = ComponentTransform.GetLocation();
+	return true;
+}
+
+#endif
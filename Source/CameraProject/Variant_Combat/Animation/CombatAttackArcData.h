@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatAttackArcData.generated.h"
+
+class UAnimMontage;
+
+/**
+ *  Baked path of a damage source bone over one attack window of a montage.
+ *  Points are in mesh component space, spaced closely enough that spheres of the arc radius overlap.
+ */
+USTRUCT()
+struct FCombatAttackArc
+{
+	GENERATED_BODY()
+
+	/** Montage the arc was baked from */
+	UPROPERTY(VisibleAnywhere, Category="Arc")
+	UAnimMontage* Montage = nullptr;
+
+	/** Bone the arc follows */
+	UPROPERTY(VisibleAnywhere, Category="Arc")
+	FName BoneName;
+
+	/** Montage time of the attack notify that ends the window */
+	UPROPERTY(VisibleAnywhere, Category="Arc")
+	float NotifyTime = 0.0f;
+
+	/** Bone positions along the window, in mesh component space */
+	UPROPERTY(VisibleAnywhere, Category="Arc")
+	TArray<FVector> Points;
+
+	/** Bounds of the points expanded by the arc radius, in mesh component space */
+	UPROPERTY(VisibleAnywhere, Category="Arc")
+	FBox Bounds = FBox(ForceInit);
+};
+
+/**
+ *  Precomputed melee hit volumes for a set of attack montages.
+ *  An editor step samples the damage source bone of every Do Attack Trace notify over its attack window,
+ *  so at runtime an attack can query the swept arc with one batched overlap instead of a fixed forward sphere sweep.
+ */
+UCLASS(BlueprintType)
+class UCombatAttackArcData : public UDataAsset
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Montages to bake. Only notifies placed on the montage itself are baked */
+	UPROPERTY(EditAnywhere, Category="Bake")
+	TArray<UAnimMontage*> Montages;
+
+	/** Length of the attack window leading up to each attack notify */
+	UPROPERTY(EditAnywhere, Category="Bake", meta = (ClampMin = 0, ClampMax = 2, Units = "s"))
+	float WindowDuration = 0.15f;
+
+	/** Rate the bone is sampled at over the window */
+	UPROPERTY(EditAnywhere, Category="Bake", meta = (ClampMin = 10, ClampMax = 240))
+	float SampleRate = 60.0f;
+
+	/** Radius of the swept hit volume around the bone path */
+	UPROPERTY(EditAnywhere, Category="Bake", meta = (ClampMin = 1, ClampMax = 200, Units = "cm"))
+	float Radius = 50.0f;
+
+	/** Baked arcs, sorted by montage and notify time */
+	UPROPERTY(VisibleAnywhere, Category="Baked")
+	TArray<FCombatAttackArc> Arcs;
+
+public:
+
+	/** Samples the montages and rebuilds the arcs */
+	UFUNCTION(CallInEditor, Category="Bake")
+	void BakeArcs();
+
+	/** Returns the arc for the latest attack notify of the bone at or before the montage position, or nullptr if there isn't one */
+	const FCombatAttackArc* FindArc(const UAnimMontage* Montage, FName BoneName, float MontagePosition) const;
+
+	/** Returns the radius of the swept hit volume */
+	float GetRadius() const { return Radius; }
+
+protected:
+
+#if WITH_EDITOR
+
+	/** Returns the mesh component space location of a bone at a montage position */
+	static bool SampleBoneLocation(const UAnimMontage* Montage, int32 BoneIndex, float MontagePosition, FVector& OutLocation);
+
+#endif
+};
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatBudgetedMeshComponent.h"
+#include "CombatAnimationBudgetSubsystem.h"
+#include "HAL/PlatformTime.h"
+
+void UCombatBudgetedMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	UCombatAnimationBudgetSubsystem* Budget = AnimationBudget.Get();
+
+	if (!Budget)
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// skipped frames only interpolate. Their time still counts, but against the next real update
+	const bool bUpdated = !(ShouldUseUpdateRateOptimizations() && AnimUpdateRateParams && AnimUpdateRateParams->ShouldSkipUpdate());
+
+	Budget->ReportMeshTick((FPlatformTime::Seconds() - StartTime) * 1000.0, bUpdated);
+}
@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "CombatBudgetedMeshComponent.generated.h"
+
+class UCombatAnimationBudgetSubsystem;
+
+/**
+ *  Skeletal mesh that times its own game thread tick for the animation budget.
+ *  While registered with UCombatAnimationBudgetSubsystem, every tick reports its duration and whether it updated the animation,
+ *  so the budget is spent against measured costs instead of a fixed estimate.
+ */
+UCLASS(ClassGroup=Combat, meta=(BlueprintSpawnableComponent))
+class UCombatBudgetedMeshComponent : public USkeletalMeshComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Budget this mesh reports its tick times to. Set while registered */
+	TWeakObjectPtr<UCombatAnimationBudgetSubsystem> AnimationBudget;
+
+public:
+
+	/** Sets the budget to report tick times to. Pass nullptr to stop reporting */
+	void SetAnimationBudget(UCombatAnimationBudgetSubsystem* InAnimationBudget) { AnimationBudget = InAnimationBudget; }
+
+	/** Times the tick and reports it to the animation budget */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+};
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHitReactions.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/World.h"
+#include "CombatRagdollSubsystem.h"
+#include "CameraProject.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animated Hit Reactions"), STAT_CombatAnimatedHitReactions, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Physics Hit Reactions"), STAT_CombatPhysicsHitReactions, STATGROUP_CameraProject);
+
+void FCombatHitReactions::React(ACharacter* Character, const FName PinnedBoneName, const FVector& DamageImpulse) const
+{
+	if (!Character)
+	{
+		return;
+	}
+
+	UAnimMontage* Montage = SelectMontage(DamageImpulse.GetSafeNormal2D(), Character->GetActorRotation());
+
+	// ragdoll mode and heavy hits try the physics blend first. So do hits without a hit animation, so they still get a reaction
+	const bool bWantsRagdoll = Mode == ECombatHitReactionMode::Ragdoll || DamageImpulse.SizeSquared() >= FMath::Square(HeavyHitImpulse) || !Montage;
+
+	if (bWantsRagdoll)
+	{
+		if (UCombatRagdollSubsystem* RagdollSubsystem = Character->GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+		{
+			if (RagdollSubsystem->RequestPartialRagdoll(Character->GetMesh(), PinnedBoneName, RagdollBlendWeight))
+			{
+				INC_DWORD_STAT(STAT_CombatPhysicsHitReactions);
+				return;
+			}
+		}
+	}
+
+	// play the directional hit animation. This is also the fallback when the ragdoll budget is full
+	if (Montage)
+	{
+		Character->PlayAnimMontage(Montage);
+
+		INC_DWORD_STAT(STAT_CombatAnimatedHitReactions);
+	}
+}
+
+UAnimMontage* FCombatHitReactions::SelectMontage(const FVector& ImpulseDirection, const FRotator& CharacterRotation) const
+{
+	// the impulse pushes away from the attacker, so the hit comes from the opposite side
+	const FVector LocalDirection = CharacterRotation.UnrotateVector(ImpulseDirection);
+
+	if (FMath::Abs(LocalDirection.X) >= FMath::Abs(LocalDirection.Y))
+	{
+		return LocalDirection.X >= 0.0f ? HitFromBack : HitFromFront;
+	}
+
+	return LocalDirection.Y >= 0.0f ? HitFromLeft : HitFromRight;
+}
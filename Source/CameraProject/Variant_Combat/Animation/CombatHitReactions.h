@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatHitReactions.generated.h"
+
+class ACharacter;
+class UAnimMontage;
+
+/** How a combat character reacts to non-lethal hits */
+UENUM(BlueprintType)
+enum class ECombatHitReactionMode : uint8
+{
+	/** Blend in a partial ragdoll on every hit, budget permitting */
+	Ragdoll,
+
+	/** Play a directional additive hit animation. Heavy hits, and hits with no animation set for their direction, blend in a partial ragdoll instead, budget permitting */
+	Animation
+};
+
+/**
+ *  Hit reaction settings shared by combat characters and enemies.
+ *  The hit animations are chosen from the direction the damage impulse pushes the character,
+ *  and should play on an additive slot so they layer over locomotion and attacks.
+ */
+USTRUCT(BlueprintType)
+struct FCombatHitReactions
+{
+	GENERATED_BODY()
+
+	/** How non-lethal hits are reacted to */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions")
+	ECombatHitReactionMode Mode = ECombatHitReactionMode::Animation;
+
+	/** Played for hits coming from the front */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions")
+	UAnimMontage* HitFromFront = nullptr;
+
+	/** Played for hits coming from behind */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions")
+	UAnimMontage* HitFromBack = nullptr;
+
+	/** Played for hits coming from the left */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions")
+	UAnimMontage* HitFromLeft = nullptr;
+
+	/** Played for hits coming from the right */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions")
+	UAnimMontage* HitFromRight = nullptr;
+
+	/** Damage impulse at or above which a hit counts as heavy and blends in a partial ragdoll */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions", meta = (ClampMin = 0, ClampMax = 5000, Units = "cm/s"))
+	float HeavyHitImpulse = 500.0f;
+
+	/** Physics blend weight of the partial ragdoll */
+	UPROPERTY(EditAnywhere, Category="Hit Reactions", meta = (ClampMin = 0, ClampMax = 1))
+	float RagdollBlendWeight = 0.5f;
+
+	/** Reacts to a non-lethal hit. The pinned bone stays animated if a partial ragdoll is used */
+	void React(ACharacter* Character, FName PinnedBoneName, const FVector& DamageImpulse) const;
+
+	/** Returns the hit animation for an impulse pushing the character in the given world direction */
+	UAnimMontage* SelectMontage(const FVector& ImpulseDirection, const FRotator& CharacterRotation) const;
+};
@@ -0,0 +1,249 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatAnimationBudgetSubsystem.h"
+#include "CombatBudgetedMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Animation Budget"), STAT_CombatAnimationBudget, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Tier: Full Rate"), STAT_CombatAnimTierFull, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Tier: Reduced Rate"), STAT_CombatAnimTierReduced, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Tier: Offscreen"), STAT_CombatAnimTierOffscreen, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Tier: Forced Full Rate"), STAT_CombatAnimTierForced, STATGROUP_CameraProject);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Anim Budget Estimate (ms)"), STAT_CombatAnimBudgetEstimate, STATGROUP_CameraProject);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Anim Update Cost (ms)"), STAT_CombatAnimUpdateCost, STATGROUP_CameraProject);
+
+namespace CombatAnimationBudget
+{
+	/** Time since the last render under which a mesh counts as on screen */
+	constexpr float RecentlyRenderedTolerance = 0.1f;
+}
+
+void UCombatAnimationBudgetSubsystem::RegisterMesh(USkeletalMeshComponent* Mesh)
+{
+	if (!Mesh || Meshes.ContainsByPredicate([Mesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == Mesh; }))
+	{
+		return;
+	}
+
+	FBudgetedMesh& Entry = Meshes.AddDefaulted_GetRef();
+	Entry.Mesh = Mesh;
+
+	// meshes that can time themselves feed the measured update cost
+	if (UCombatBudgetedMeshComponent* BudgetedMesh = Cast<UCombatBudgetedMeshComponent>(Mesh))
+	{
+		BudgetedMesh->SetAnimationBudget(this);
+	}
+}
+
+void UCombatAnimationBudgetSubsystem::UnregisterMesh(USkeletalMeshComponent* Mesh)
+{
+	const int32 NumRemoved = Meshes.RemoveAll([Mesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == Mesh; });
+
+	if (NumRemoved > 0 && Mesh)
+	{
+		ApplyUpdateRate(Mesh, 1, 1, 1);
+
+		if (UCombatBudgetedMeshComponent* BudgetedMesh = Cast<UCombatBudgetedMeshComponent>(Mesh))
+		{
+			BudgetedMesh->SetAnimationBudget(nullptr);
+		}
+	}
+}
+
+void UCombatAnimationBudgetSubsystem::ReportMeshTick(const double TickTimeMs, const bool bUpdated)
+{
+	PendingTickTimeMs += TickTimeMs;
+
+	if (bUpdated)
+	{
+		++PendingNumUpdates;
+	}
+}
+
+bool UCombatAnimationBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatAnimationBudgetSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatAnimationBudget);
+
+	// fold the mesh ticks since the last update into the running cost per update.
+	// Tickables run after the tick groups, so this frame's mesh ticks are already in
+	if (PendingNumUpdates > 0)
+	{
+		const float FrameCostMs = static_cast<float>(PendingTickTimeMs / PendingNumUpdates);
+
+		MeasuredUpdateCostMs = MeasuredUpdateCostMs > 0.0f ? FMath::Lerp(MeasuredUpdateCostMs, FrameCostMs, 1.0f / FMath::Max(CostAveragingFrames, 1)) : FrameCostMs;
+
+		PendingTickTimeMs = 0.0;
+		PendingNumUpdates = 0;
+	}
+
+	SET_FLOAT_STAT(STAT_CombatAnimUpdateCost, MeasuredUpdateCostMs);
+
+	if (Meshes.IsEmpty() || VisibleUpdateRates.IsEmpty())
+	{
+		return;
+	}
+
+	// gather the player camera locations
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get(); PlayerController && PlayerController->PlayerCameraManager)
+		{
+			ViewLocations.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	const int32 SlowestVisibleRate = VisibleUpdateRates.Last();
+	const int32 MaxInterpolatedRate = FMath::Max(SlowestVisibleRate, OffscreenUpdateRate);
+	const float UpdateCostMs = FMath::Max(MeasuredUpdateCostMs > 0.0f ? MeasuredUpdateCostMs : EstimatedUpdateCostMs, UE_KINDA_SMALL_NUMBER);
+
+	// budget left, in full rate updates per frame
+	float Budget = TargetBudgetMs / UpdateCostMs;
+
+	int32 NumForced = 0;
+	int32 NumOffscreen = 0;
+
+	// drop destroyed meshes first, so the entries we rank below don't move
+	Meshes.RemoveAll([](const FBudgetedMesh& Entry) { return !Entry.Mesh.IsValid(); });
+
+	// meshes we get to rank, largest on screen first
+	TArray<FBudgetedMesh*> Ranked;
+	Ranked.Reserve(Meshes.Num());
+
+	for (FBudgetedMesh& Entry : Meshes)
+	{
+		USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+
+		// pooled, frozen or ragdolling meshes aren't animating
+		if (!Mesh->IsComponentTickEnabled() || Mesh->IsSimulatingPhysics())
+		{
+			continue;
+		}
+
+		// montages drive attack notifies and traces, so they always get every frame
+		const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+
+		if (AnimInstance && AnimInstance->IsAnyMontagePlaying())
+		{
+			if (Entry.UpdateRate != 1)
+			{
+				Entry.UpdateRate = 1;
+				ApplyUpdateRate(Mesh, 1, 1, MaxInterpolatedRate);
+			}
+
+			Budget -= 1.0f;
+			++NumForced;
+			continue;
+		}
+
+		Entry.bOnScreen = Mesh->WasRecentlyRendered(CombatAnimationBudget::RecentlyRenderedTolerance);
+
+		if (!Entry.bOnScreen)
+		{
+			if (Entry.UpdateRate != OffscreenUpdateRate)
+			{
+				Entry.UpdateRate = OffscreenUpdateRate;
+				ApplyUpdateRate(Mesh, OffscreenUpdateRate, OffscreenUpdateRate, MaxInterpolatedRate);
+			}
+
+			Budget -= 1.0f / OffscreenUpdateRate;
+			++NumOffscreen;
+			continue;
+		}
+
+		// screen size is the bounds radius over the distance to the closest view
+		double ClosestDistance = TNumericLimits<double>::Max();
+
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			ClosestDistance = FMath::Min(ClosestDistance, FVector::Dist(ViewLocation, Mesh->Bounds.Origin));
+		}
+
+		Entry.ScreenSize = Mesh->Bounds.SphereRadius / FMath::Max(ClosestDistance, 1.0);
+		Ranked.Add(&Entry);
+	}
+
+	Ranked.Sort([](const FBudgetedMesh& A, const FBudgetedMesh& B) { return A.ScreenSize > B.ScreenSize; });
+
+	// every ranked mesh is guaranteed at least the slowest rate
+	Budget -= Ranked.Num() / static_cast<float>(SlowestVisibleRate);
+
+	int32 NumFull = 0;
+	int32 NumReduced = 0;
+
+	for (FBudgetedMesh* Entry : Ranked)
+	{
+		// give back this mesh's guaranteed share, then take the fastest rate that fits
+		Budget += 1.0f / SlowestVisibleRate;
+
+		int32 UpdateRate = SlowestVisibleRate;
+
+		for (const int32 Rate : VisibleUpdateRates)
+		{
+			if (Rate <= 1 && Entry->ScreenSize < ReducedRateScreenSize)
+			{
+				continue;
+			}
+
+			if (1.0f / Rate <= Budget)
+			{
+				UpdateRate = Rate;
+				break;
+			}
+		}
+
+		Budget -= 1.0f / UpdateRate;
+
+		UpdateRate <= 1 ? ++NumFull : ++NumReduced;
+
+		if (Entry->UpdateRate != UpdateRate)
+		{
+			Entry->UpdateRate = UpdateRate;
+			ApplyUpdateRate(Entry->Mesh.Get(), UpdateRate, OffscreenUpdateRate, MaxInterpolatedRate);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CombatAnimTierFull, NumFull);
+	SET_DWORD_STAT(STAT_CombatAnimTierReduced, NumReduced);
+	SET_DWORD_STAT(STAT_CombatAnimTierOffscreen, NumOffscreen);
+	SET_DWORD_STAT(STAT_CombatAnimTierForced, NumForced);
+	SET_FLOAT_STAT(STAT_CombatAnimBudgetEstimate, TargetBudgetMs - Budget * UpdateCostMs);
+}
+
+TStatId UCombatAnimationBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatAnimationBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatAnimationBudgetSubsystem::ApplyUpdateRate(USkeletalMeshComponent* Mesh, const int32 UpdateRate, const int32 NonRenderedUpdateRate, const int32 MaxInterpolatedRate)
+{
+	FAnimUpdateRateParameters* Params = Mesh ? Mesh->AnimUpdateRateParams : nullptr;
+
+	if (!Params)
+	{
+		return;
+	}
+
+	// the engine reads the frame skip from the LOD map, so map every LOD to our rate
+	Params->bShouldUseLODMap = true;
+	Params->LODToFrameSkipMap.Reset();
+
+	for (int32 LODIndex = 0; LODIndex < FMath::Max(Mesh->GetNumLODs(), 1); ++LODIndex)
+	{
+		Params->LODToFrameSkipMap.Add(LODIndex, UpdateRate - 1);
+	}
+
+	Params->BaseNonRenderedUpdateRate = NonRenderedUpdateRate;
+	Params->MaxEvalRateForInterpolation = MaxInterpolatedRate;
+}
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatAnimationBudgetSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ *  World subsystem that budgets animation updates for combat enemies.
+ *  Each frame, registered meshes are ranked by their screen size as seen from the closest player camera,
+ *  and handed update rates through the engine's update rate optimizations so the animation cost stays under a target.
+ *  The cost of an update is measured by UCombatBudgetedMeshComponent meshes and averaged over a window of frames,
+ *  so the number of updates granted follows the real cost. Larger meshes are granted faster rates first. Skipped frames are interpolated.
+ *  Offscreen meshes update at a fixed low rate. Meshes playing a montage always update every frame,
+ *  so attack notifies fire on the frame they're authored for and sample up to date bone transforms.
+ */
+UCLASS(Config=Game)
+class UCombatAnimationBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Target animation cost for all budgeted meshes, per frame */
+	UPROPERTY(Config)
+	float TargetBudgetMs = 1.0f;
+
+	/** Cost of one full rate animation update of a budgeted mesh, assumed until one has been measured */
+	UPROPERTY(Config)
+	float EstimatedUpdateCostMs = 0.1f;
+
+	/** Number of frames the measured update cost is averaged over */
+	UPROPERTY(Config)
+	int32 CostAveragingFrames = 60;
+
+	/** Update rates available to visible meshes, fastest first. A rate of N updates the mesh every N frames */
+	UPROPERTY(Config)
+	TArray<int32> VisibleUpdateRates = { 1, 2, 4 };
+
+	/** Update rate for meshes that weren't rendered recently */
+	UPROPERTY(Config)
+	int32 OffscreenUpdateRate = 8;
+
+	/** Meshes with a smaller screen size never get the fastest rate, even under budget */
+	UPROPERTY(Config)
+	float ReducedRateScreenSize = 0.05f;
+
+	/** A budgeted mesh */
+	struct FBudgetedMesh
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		int32 UpdateRate = 1;
+		float ScreenSize = 0.0f;
+		bool bOnScreen = false;
+	};
+
+	/** Registered meshes */
+	TArray<FBudgetedMesh> Meshes;
+
+	/** Measured game thread cost of one full rate update, averaged over CostAveragingFrames. Zero until the first measurement */
+	float MeasuredUpdateCostMs = 0.0f;
+
+	/** Tick time reported by the budgeted meshes since the last measured update */
+	double PendingTickTimeMs = 0.0;
+
+	/** Animation updates reported by the budgeted meshes since the last fold into the measured cost */
+	int32 PendingNumUpdates = 0;
+
+public:
+
+	/** Starts budgeting the mesh's animation. The mesh must have update rate optimizations enabled before it's registered with the world */
+	void RegisterMesh(USkeletalMeshComponent* Mesh);
+
+	/** Stops budgeting the mesh and puts it back to full rate */
+	void UnregisterMesh(USkeletalMeshComponent* Mesh);
+
+	/** Records the game thread time of a budgeted mesh's tick, and whether it updated the animation or only interpolated */
+	void ReportMeshTick(double TickTimeMs, bool bUpdated);
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Ranks the meshes and assigns their update rates */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Forces the mesh's update rate, regardless of its LOD */
+	static void ApplyUpdateRate(USkeletalMeshComponent* Mesh, int32 UpdateRate, int32 NonRenderedUpdateRate, int32 MaxInterpolatedRate);
+};
@@ -3,17 +3,22 @@
 
 #include "CombatCharacter.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "CameraProbeSpringArmComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputComponent.h"
-#include "CombatLifeBar.h"
+#include "CombatLifeBarComponent.h"
 #include "Engine/DamageEvents.h"
 #include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
+#include "CombatMeleeSubsystem.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatFactionComponent.h"
+#include "CombatAttackArcData.h"
+#include "CombatRagdollSubsystem.h"
 
 ACombatCharacter::ACombatCharacter()
 {
@@ -29,7 +34,7 @@ ACombatCharacter::ACombatCharacter()
 	GetCharacterMovement()->MaxWalkSpeed = 400.0f;
 
 	// create the camera boom
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	CameraBoom = CreateDefaultSubobject<UCameraProbeSpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
 
 	CameraBoom->TargetArmLength = DefaultCameraDistance;
@@ -42,9 +47,14 @@ ACombatCharacter::ACombatCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
 
-	// create the life bar widget component
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
+	// create the life bar. The player's bar stays up even at full health
+	LifeBar = CreateDefaultSubobject<UCombatLifeBarComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
+	LifeBar->SetHideWhenFull(false);
+
+	// create the faction component. Combat code checks factions, the tag is kept for Blueprints
+	Faction = CreateDefaultSubobject<UCombatFactionComponent>(TEXT("Faction"));
+	Faction->SetFaction(ECombatFaction::Player);
 
 	// set the player tag
 	Tags.Add(FName("Player"));
@@ -175,7 +185,7 @@ void ACombatCharacter::ResetHP()
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	LifeBar->SetLifePercentage(1.0f);
 }
 
 void ACombatCharacter::ComboAttack()
@@ -253,46 +263,59 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
-
-	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
-
 	// check for pawn and world dynamic collision object types
 	FCollisionObjectQueryParams ObjectParams;
 	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	UCombatMeleeSubsystem* MeleeSubsystem = GetWorld()->GetSubsystem<UCombatMeleeSubsystem>();
 
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	if (!MeleeSubsystem)
+	{
+		return;
+	}
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	const FMaskFilter IgnoreMask = UCombatFactionComponent::GetAttackIgnoreMask(Faction->GetFaction());
+
+	// use the baked arc for this attack window if there is one
+	if (AttackArcs)
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		const UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+		const UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+
+		if (const FCombatAttackArc* Arc = Montage ? AttackArcs->FindArc(Montage, DamageSourceBone, AnimInstance->Montage_GetPosition(Montage)) : nullptr)
 		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			MeleeSubsystem->QueueArcAttack(this, *Arc, AttackArcs->GetRadius(), GetMesh()->GetComponentTransform(), ObjectParams, IgnoreMask);
+			return;
+		}
+	}
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+	// start at the provided socket location, sweep forward
+	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
+	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
+
+	// queue the sweep. Hits come back through ApplyAttackHit once the frame's attacks are resolved
+	MeleeSubsystem->QueueAttack(this, TraceStart, TraceEnd, MeleeTraceRadius, ObjectParams, IgnoreMask);
+}
 
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+void ACombatCharacter::ApplyAttackHit(const FHitResult& Hit)
+{
+	// check if we've hit a damageable actor
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Hit.GetActor());
 
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
+	if (Damageable)
+	{
+		// knock upwards and away from the impact normal
+		const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+
+		// queue the damage event for the actor. It's applied with the rest of the frame's damage
+		if (UCombatDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+		{
+			DamageSubsystem->QueueDamage(Hit.GetActor(), MeleeDamage, this, Hit.ImpactPoint, Impulse);
 		}
+
+		// call the BP handler to play effects, etc.
+		DealtDamage(MeleeDamage, Hit.ImpactPoint);
 	}
 }
 
@@ -388,6 +411,13 @@ void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVe
 		// apply the knockback impulse
 		GetCharacterMovement()->AddImpulse(DamageImpulse, true);
 
+		// react to the hit if we survived it, keeping the pelvis vertical if it ragdolls.
+		// this goes first so a partial ragdoll started by this hit receives its impulse
+		if (CurrentHP > 0.0f)
+		{
+			HitReactions.React(this, PelvisBoneName, DamageImpulse);
+		}
+
 		// is the character ragdolling?
 		if (GetMesh()->IsSimulatingPhysics())
 		{
@@ -406,8 +436,15 @@ void ACombatCharacter::HandleDeath()
 	// disable movement while we're dead
 	GetCharacterMovement()->DisableMovement();
 
-	// enable full ragdoll physics
-	GetMesh()->SetSimulatePhysics(true);
+	// enable full ragdoll physics. The player always ragdolls, but still counts against the budget
+	if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+	{
+		RagdollSubsystem->RequestRagdoll(GetMesh(), true);
+
+	} else {
+
+		GetMesh()->SetSimulatePhysics(true);
+	}
 
 	// hide the life bar
 	LifeBar->SetHiddenInGame(true);
@@ -455,11 +492,7 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
-
-		// enable partial ragdoll physics, but keep the pelvis vertical
-		GetMesh()->SetPhysicsBlendWeight(0.5f);
-		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		LifeBar->SetLifePercentage(CurrentHP / MaxHP);
 	}
 
 	// return the received damage amount
@@ -474,7 +507,10 @@ void ACombatCharacter::Landed(const FHitResult& Hit)
 	if (CurrentHP >= 0.0f)
 	{
 		// disable ragdoll physics
-		GetMesh()->SetPhysicsBlendWeight(0.0f);
+		if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+		{
+			RagdollSubsystem->EndPartialRagdoll(GetMesh());
+		}
 	}
 }
 
@@ -482,10 +518,6 @@ void ACombatCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// get the life bar from the widget component
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
-
 	// initialize the camera
 	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
 
@@ -493,7 +525,7 @@ void ACombatCharacter::BeginPlay()
 	MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
 	// set the life bar color
-	LifeBarWidget->SetBarColor(LifeBarColor);
+	LifeBar->SetBarColor(LifeBarColor);
 
 	// reset HP to maximum
 	ResetHP();
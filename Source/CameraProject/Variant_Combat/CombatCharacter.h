@@ -6,6 +6,7 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatHitReactions.h"
 #include "Animation/AnimInstance.h"
 #include "CombatCharacter.generated.h"
 
@@ -13,8 +14,9 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
-class UCombatLifeBar;
-class UWidgetComponent;
+class UCombatFactionComponent;
+class UCombatAttackArcData;
+class UCombatLifeBarComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
@@ -39,9 +41,13 @@ class ACombatCharacter : public ACharacter, public ICombatAttacker, public IComb
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
 
-	/** Life bar widget component */
+	/** Life bar component */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
+	UCombatLifeBarComponent* LifeBar;
+
+	/** Combat faction component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCombatFactionComponent* Faction;
 	
 protected:
 
@@ -81,7 +87,7 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category="Damage")
 	float CurrentHP = 0.0f;
 
-	/** Life bar widget fill color */
+	/** Life bar fill color */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FLinearColor LifeBarColor;
 
@@ -89,9 +95,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
+	/** How non-lethal hits are reacted to */
 	UPROPERTY(EditAnywhere, Category="Damage")
-	TObjectPtr<UCombatLifeBar> LifeBarWidget;
+	FCombatHitReactions HitReactions;
 
 	/** Max amount of time that may elapse for a non-combo attack input to not be considered stale */
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
@@ -111,6 +117,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
 	float MeleeTraceRadius = 75.0f;
 
+	/** Optional baked attack arcs. Attacks with a baked arc query the arc instead of sweeping a sphere forward */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace")
+	UCombatAttackArcData* AttackArcs;
+
 	/** Distance ahead of the character that enemies will be notified of incoming attacks */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units="cm"))
 	float DangerTraceDistance = 300.0f;
@@ -262,6 +272,9 @@ public:
 	/** Performs the collision check for an attack */
 	virtual void DoAttackTrace(FName DamageSourceBone) override;
 
+	/** Applies a resolved hit from the attack trace */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	/** Performs the combo string check */
 	virtual void CheckCombo() override;
 
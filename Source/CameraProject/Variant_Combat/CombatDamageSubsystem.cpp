@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatDamageSubsystem.h"
+#include "CombatDamageable.h"
+#include "GameFramework/Actor.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Flush"), STAT_CombatDamageFlush, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Commands Queued"), STAT_CombatDamageQueued, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Commands Applied"), STAT_CombatDamageApplied, STATGROUP_CameraProject);
+
+void UCombatDamageSubsystem::QueueDamage(AActor* Target, const float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
+{
+	if (!Target || !Cast<ICombatDamageable>(Target))
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_CombatDamageQueued);
+
+	// merge into the target's existing command, or start a new one
+	int32& CommandIndex = TargetToCommand.FindOrAdd(Target, INDEX_NONE);
+
+	if (CommandIndex == INDEX_NONE)
+	{
+		CommandIndex = Commands.AddDefaulted();
+		Commands[CommandIndex].Target = Target;
+	}
+
+	FDamageCommand& Command = Commands[CommandIndex];
+	Command.Damage += Damage;
+	Command.DamageImpulse += DamageImpulse;
+
+	// the strongest hit decides where the damage lands and who caused it
+	if (Damage > Command.StrongestDamage)
+	{
+		Command.StrongestDamage = Damage;
+		Command.DamageLocation = DamageLocation;
+		Command.DamageCauser = DamageCauser;
+	}
+}
+
+void UCombatDamageSubsystem::FlushDamage()
+{
+	if (Commands.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatDamageFlush);
+
+	// take the buffer, so damage caused by the damage goes into the next flush
+	TArray<FDamageCommand> FlushedCommands = MoveTemp(Commands);
+	Commands.Reset();
+	TargetToCommand.Reset();
+
+	for (const FDamageCommand& Command : FlushedCommands)
+	{
+		if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(Command.Target.Get()))
+		{
+			Damageable->ApplyDamage(Command.Damage, Command.DamageCauser.Get(), Command.DamageLocation, Command.DamageImpulse);
+
+			INC_DWORD_STAT(STAT_CombatDamageApplied);
+		}
+	}
+}
+
+bool UCombatDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatDamageSubsystem::Tick(float DeltaTime)
+{
+	FlushDamage();
+}
+
+TStatId UCombatDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDamageSubsystem, STATGROUP_Tickables);
+}
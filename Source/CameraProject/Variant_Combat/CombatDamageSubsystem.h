@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDamageSubsystem.generated.h"
+
+/**
+ *  World subsystem that buffers damage and applies it in one dedicated phase.
+ *  Damage sources queue commands here instead of calling ICombatDamageable::ApplyDamage mid-frame.
+ *  On flush, commands for the same target are coalesced into one ApplyDamage call with the damage and impulses summed,
+ *  so each target takes one round of physics changes, widget updates and Blueprint events per frame.
+ *  Targets are applied in the order they were first damaged, so results are deterministic.
+ */
+UCLASS()
+class UCombatDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Coalesced damage for one target */
+	struct FDamageCommand
+	{
+		TWeakObjectPtr<AActor> Target;
+		TWeakObjectPtr<AActor> DamageCauser;
+		float Damage = 0.0f;
+		FVector DamageLocation = FVector::ZeroVector;
+		FVector DamageImpulse = FVector::ZeroVector;
+		float StrongestDamage = -1.0f;
+	};
+
+	/** Commands waiting for the next flush, in first-damaged order */
+	TArray<FDamageCommand> Commands;
+
+	/** Target to command index lookup */
+	TMap<TWeakObjectPtr<AActor>, int32> TargetToCommand;
+
+public:
+
+	/** Queues damage for a target implementing ICombatDamageable */
+	void QueueDamage(AActor* Target, float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse);
+
+	/** Applies every queued command. Damage queued while flushing waits for the next flush */
+	void FlushDamage();
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Flushes anything queued since the last flush */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+};
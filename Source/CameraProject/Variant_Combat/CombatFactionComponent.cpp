@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatFactionComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+
+/** Factions each faction is hostile to, indexed by faction */
+static constexpr FMaskFilter FactionHostility[] =
+{
+	/* Player */	1u << static_cast<uint8>(ECombatFaction::Enemy),
+	/* Enemy */		1u << static_cast<uint8>(ECombatFaction::Player),
+	/* Neutral */	0u
+};
+
+static_assert(UE_ARRAY_COUNT(FactionHostility) == static_cast<uint8>(ECombatFaction::Neutral) + 1, "Every faction needs a hostility row");
+
+/** All mask bits used by factions */
+static constexpr FMaskFilter AllFactionsMask = (1u << UE_ARRAY_COUNT(FactionHostility)) - 1;
+
+UCombatFactionComponent::UCombatFactionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCombatFactionComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ApplyMaskFilter();
+}
+
+void UCombatFactionComponent::SetFaction(const ECombatFaction NewFaction)
+{
+	Faction = NewFaction;
+
+	if (HasBegunPlay())
+	{
+		ApplyMaskFilter();
+	}
+}
+
+FMaskFilter UCombatFactionComponent::GetHostileMask(const ECombatFaction InFaction)
+{
+	return FactionHostility[static_cast<uint8>(InFaction)];
+}
+
+FMaskFilter UCombatFactionComponent::GetAttackIgnoreMask(const ECombatFaction InFaction)
+{
+	return AllFactionsMask & ~GetHostileMask(InFaction);
+}
+
+bool UCombatFactionComponent::IsHostileShape(const ECombatFaction InFaction, const UPrimitiveComponent* Shape)
+{
+	return Shape && (Shape->GetMaskFilter() & GetHostileMask(InFaction)) != 0;
+}
+
+bool UCombatFactionComponent::IsHostileTo(const ECombatFaction InFaction, const AActor* Other)
+{
+	// the faction bit is already on the owner's primitives, so read it back from the root instead of finding the component
+	return Other && IsHostileShape(InFaction, Cast<UPrimitiveComponent>(Other->GetRootComponent()));
+}
+
+void UCombatFactionComponent::ApplyMaskFilter() const
+{
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(GetOwner());
+
+	for (UPrimitiveComponent* Primitive : Primitives)
+	{
+		Primitive->SetMaskFilter(GetFactionMask(Faction));
+	}
+}
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "CombatFactionComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/** Combat factions. Each maps to one collision mask filter bit, so there can be at most six */
+UENUM(BlueprintType)
+enum class ECombatFaction : uint8
+{
+	Player,
+	Enemy,
+	Neutral
+};
+
+/**
+ *  Tags its owner with a combat faction.
+ *  The faction bit is written to the mask filter of the owner's primitives, so attack sweeps can drop
+ *  non-hostile shapes inside the physics query through FCollisionQueryParams::IgnoreMask.
+ *  Shapes of actors without a faction component have no mask filter bits and pass the query, so attackers that should only
+ *  hit hostiles also check IsHostileShape on the hit component. Actors without a faction component are hostile to no one.
+ *  The mask filter doubles as a cache of the faction on each shape, so hostility checks never look up the component.
+ */
+UCLASS(ClassGroup=Combat, meta=(BlueprintSpawnableComponent))
+class UCombatFactionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Faction of the owner */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Faction")
+	ECombatFaction Faction = ECombatFaction::Neutral;
+
+public:
+
+	/** Constructor */
+	UCombatFactionComponent();
+
+	/** Writes the faction bit to the owner's primitives */
+	virtual void BeginPlay() override;
+
+	/** Returns the owner's faction */
+	ECombatFaction GetFaction() const { return Faction; }
+
+	/** Sets the owner's faction and updates its primitives */
+	void SetFaction(ECombatFaction NewFaction);
+
+	/** Returns the mask filter bit for a faction */
+	static FMaskFilter GetFactionMask(ECombatFaction InFaction) { return static_cast<FMaskFilter>(1u << static_cast<uint8>(InFaction)); }
+
+	/** Returns the mask of the factions the given faction is hostile to */
+	static FMaskFilter GetHostileMask(ECombatFaction InFaction);
+
+	/** Returns the ignore mask for attack sweeps from the given faction. It filters out every faction it isn't hostile to */
+	static FMaskFilter GetAttackIgnoreMask(ECombatFaction InFaction);
+
+	/** Returns true if the shape's mask filter has a faction hostile to the given one */
+	static bool IsHostileShape(ECombatFaction InFaction, const UPrimitiveComponent* Shape);
+
+	/** Returns true if the actor has a faction hostile to the given one. Reads the mask filter of the actor's root primitive */
+	static bool IsHostileTo(ECombatFaction InFaction, const AActor* Other);
+
+protected:
+
+	/** Writes the faction bit to the mask filter of the owner's primitives */
+	void ApplyMaskFilter() const;
+};
@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatMeleeSubsystem.h"
+#include "CombatAttacker.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatAttackArcData.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+#include "Engine/OverlapResult.h"
+#include "HAL/IConsoleManager.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Melee Queue Resolve"), STAT_CombatMeleeResolve, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Sweeps"), STAT_CombatMeleeSweeps, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Arc Queries"), STAT_CombatMeleeArcs, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Duplicate Hits Skipped"), STAT_CombatMeleeDuplicates, STATGROUP_CameraProject);
+
+static TAutoConsoleVariable<bool> CVarCombatAsyncMeleeSweeps(
+	TEXT("Combat.AsyncMeleeSweeps"),
+	false,
+	TEXT("If true, melee attack sweeps run on the async trace system and their hits resolve one frame later."),
+	ECVF_Default);
+
+void UCombatMeleeSubsystem::QueueAttack(AActor* Attacker, const FVector& Start, const FVector& End, const float Radius, const FCollisionObjectQueryParams& ObjectParams, const FMaskFilter IgnoreMask)
+{
+	if (!Attacker)
+	{
+		return;
+	}
+
+	FMeleeRequest Request;
+	Request.Attacker = Attacker;
+	Request.Start = Start;
+	Request.End = End;
+	Request.Radius = Radius;
+	Request.ObjectParams = ObjectParams;
+	Request.IgnoreMask = IgnoreMask;
+
+	INC_DWORD_STAT(STAT_CombatMeleeSweeps);
+
+	if (CVarCombatAsyncMeleeSweeps.GetValueOnGameThread())
+	{
+		// start the sweep now so it runs with the rest of the frame's async traces
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatMelee), false, Attacker);
+		QueryParams.IgnoreMask = IgnoreMask;
+		Request.AsyncHandle = GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), QueryParams);
+
+		QueuedAsyncRequests.Add(MoveTemp(Request));
+
+	} else {
+
+		PendingRequests.Add(MoveTemp(Request));
+	}
+}
+
+void UCombatMeleeSubsystem::QueueArcAttack(AActor* Attacker, const FCombatAttackArc& Arc, const float Radius, const FTransform& MeshTransform, const FCollisionObjectQueryParams& ObjectParams, const FMaskFilter IgnoreMask)
+{
+	if (!Attacker || Arc.Points.IsEmpty())
+	{
+		return;
+	}
+
+	FMeleeRequest Request;
+	Request.Attacker = Attacker;
+	Request.Radius = Radius;
+	Request.ObjectParams = ObjectParams;
+	Request.IgnoreMask = IgnoreMask;
+
+	// place the arc and its bounds in the world
+	Request.Start = Request.End = MeshTransform.TransformPosition(Arc.Bounds.GetCenter());
+	Request.ArcRotation = MeshTransform.GetRotation();
+	Request.ArcExtent = Arc.Bounds.GetExtent() * MeshTransform.GetScale3D().GetAbs();
+
+	Request.ArcPoints.Reserve(Arc.Points.Num());
+
+	for (const FVector& Point : Arc.Points)
+	{
+		Request.ArcPoints.Add(MeshTransform.TransformPosition(Point));
+	}
+
+	INC_DWORD_STAT(STAT_CombatMeleeArcs);
+
+	PendingRequests.Add(MoveTemp(Request));
+}
+
+bool UCombatMeleeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatMeleeSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatMeleeResolve);
+
+	UWorld* World = GetWorld();
+
+	ResolvedPairs.Reset();
+
+	// resolve last frame's async sweeps
+	FTraceDatum Datum;
+
+	for (const FMeleeRequest& Request : InFlightAsyncRequests)
+	{
+		if (World->QueryTraceData(Request.AsyncHandle, Datum))
+		{
+			ResolveHits(Request, Datum.OutHits);
+		}
+	}
+
+	InFlightAsyncRequests = MoveTemp(QueuedAsyncRequests);
+	QueuedAsyncRequests.Reset();
+
+	// run this frame's sync sweeps
+	TArray<FHitResult> OutHits;
+
+	for (const FMeleeRequest& Request : PendingRequests)
+	{
+		AActor* Attacker = Request.Attacker.Get();
+
+		if (!Attacker)
+		{
+			continue;
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatMelee), false, Attacker);
+		QueryParams.IgnoreMask = Request.IgnoreMask;
+
+		OutHits.Reset();
+
+		if (Request.ArcPoints.IsEmpty())
+		{
+			World->SweepMultiByObjectType(OutHits, Request.Start, Request.End, FQuat::Identity, Request.ObjectParams, FCollisionShape::MakeSphere(Request.Radius), QueryParams);
+
+		} else {
+
+			ResolveArc(World, Request, QueryParams, OutHits);
+		}
+
+		ResolveHits(Request, OutHits);
+	}
+
+	PendingRequests.Reset();
+
+	// apply the damage from this batch right away, instead of waiting for the damage subsystem's own tick
+	if (UCombatDamageSubsystem* DamageSubsystem = World->GetSubsystem<UCombatDamageSubsystem>())
+	{
+		DamageSubsystem->FlushDamage();
+	}
+}
+
+TStatId UCombatMeleeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatMeleeSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatMeleeSubsystem::ResolveArc(UWorld* World, const FMeleeRequest& Request, const FCollisionQueryParams& QueryParams, TArray<FHitResult>& OutHits) const
+{
+	// one broad overlap for the whole arc
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Request.Start, Request.ArcRotation, Request.ObjectParams, FCollisionShape::MakeBox(Request.ArcExtent), QueryParams);
+
+	const float RadiusSquared = FMath::Square(Request.Radius);
+	const AActor* Attacker = Request.Attacker.Get();
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+
+		if (!Component)
+		{
+			continue;
+		}
+
+		// the first arc point within reach of the candidate decides the hit
+		for (const FVector& Point : Request.ArcPoints)
+		{
+			FVector ClosestPoint;
+			float DistanceSquared;
+
+			if (Component->GetSquaredDistanceToCollision(Point, DistanceSquared, ClosestPoint) && DistanceSquared <= RadiusSquared)
+			{
+				// face the normal back towards the arc, or towards the attacker if the point is inside the candidate
+				const FVector Normal = DistanceSquared > UE_KINDA_SMALL_NUMBER ? (Point - ClosestPoint).GetSafeNormal() : (Attacker->GetActorLocation() - ClosestPoint).GetSafeNormal();
+
+				OutHits.Emplace(Overlap.GetActor(), Component, ClosestPoint, Normal);
+				break;
+			}
+		}
+	}
+}
+
+void UCombatMeleeSubsystem::ResolveHits(const FMeleeRequest& Request, const TArray<FHitResult>& Hits)
+{
+	ICombatAttacker* Attacker = Cast<ICombatAttacker>(Request.Attacker.Get());
+
+	if (!Attacker)
+	{
+		return;
+	}
+
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* Victim = Hit.GetActor();
+
+		if (!Victim)
+		{
+			continue;
+		}
+
+		// each attacker hits each victim once per batch, even across several bones or notifies
+		bool bAlreadyResolved = false;
+		ResolvedPairs.Add(TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>>(Request.Attacker, Victim), &bAlreadyResolved);
+
+		if (bAlreadyResolved)
+		{
+			INC_DWORD_STAT(STAT_CombatMeleeDuplicates);
+			continue;
+		}
+
+		Attacker->ApplyAttackHit(Hit);
+	}
+}
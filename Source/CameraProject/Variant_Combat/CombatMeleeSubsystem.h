@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "CollisionQueryParams.h"
+#include "CombatMeleeSubsystem.generated.h"
+
+struct FCombatAttackArc;
+
+/**
+ *  World subsystem that resolves melee attack traces in one batch per frame.
+ *  Attack notifies queue their sweeps here instead of sweeping and applying damage during animation notify dispatch.
+ *  The queue is resolved after animation has finished for the frame, and each attacker hits each victim at most once per batch.
+ *  With Combat.AsyncMeleeSweeps enabled, the sweeps run on the async trace system and resolve on the next frame.
+ *  Baked attack arcs are resolved with one overlap over the arc's bounds, then tested against the arc's points.
+ */
+UCLASS()
+class UCombatMeleeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** A queued melee sweep */
+	struct FMeleeRequest
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		float Radius = 0.0f;
+		FCollisionObjectQueryParams ObjectParams;
+		FMaskFilter IgnoreMask = 0;
+		FTraceHandle AsyncHandle;
+
+		/** World space arc points. If set, Start is the center of the arc bounds */
+		TArray<FVector> ArcPoints;
+		FQuat ArcRotation = FQuat::Identity;
+		FVector ArcExtent = FVector::ZeroVector;
+	};
+
+	/** Sync sweeps queued this frame */
+	TArray<FMeleeRequest> PendingRequests;
+
+	/** Async sweeps queued this frame, resolved next frame */
+	TArray<FMeleeRequest> QueuedAsyncRequests;
+
+	/** Async sweeps queued last frame, resolved this frame */
+	TArray<FMeleeRequest> InFlightAsyncRequests;
+
+	/** Attacker and victim pairs already resolved this batch */
+	TSet<TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>>> ResolvedPairs;
+
+public:
+
+	/**
+	 *  Queues a melee sphere sweep for the attacker. The attacker must implement ICombatAttacker to receive the hits.
+	 *  Shapes whose mask filter shares a bit with IgnoreMask are rejected by the query, see UCombatFactionComponent.
+	 */
+	void QueueAttack(AActor* Attacker, const FVector& Start, const FVector& End, float Radius, const FCollisionObjectQueryParams& ObjectParams, FMaskFilter IgnoreMask = 0);
+
+	/** Queues a baked attack arc for the attacker, placed by its mesh transform. Arcs always resolve in this frame's batch */
+	void QueueArcAttack(AActor* Attacker, const FCombatAttackArc& Arc, float Radius, const FTransform& MeshTransform, const FCollisionObjectQueryParams& ObjectParams, FMaskFilter IgnoreMask = 0);
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Resolves the queued attacks */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Overlaps the arc bounds and builds a hit for every candidate within the radius of an arc point */
+	void ResolveArc(UWorld* World, const FMeleeRequest& Request, const FCollisionQueryParams& QueryParams, TArray<FHitResult>& OutHits) const;
+
+	/** Passes each new victim in the hits to the attacker */
+	void ResolveHits(const FMeleeRequest& Request, const TArray<FHitResult>& Hits);
+};
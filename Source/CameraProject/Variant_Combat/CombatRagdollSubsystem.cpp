@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatRagdollSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Budget"), STAT_CombatRagdollBudget, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulating Ragdolls"), STAT_CombatSimulatingRagdolls, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulating Ragdoll Bodies"), STAT_CombatSimulatingRagdollBodies, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frozen Ragdolls"), STAT_CombatFrozenRagdolls, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Partial Ragdolls"), STAT_CombatPartialRagdolls, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdolls Refused"), STAT_CombatRagdollsRefused, STATGROUP_CameraProject);
+
+bool UCombatRagdollSubsystem::RequestRagdoll(USkeletalMeshComponent* Mesh, const bool bForce)
+{
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	if (GetNumSimulating() >= MaxSimulatedRagdolls)
+	{
+		if (!bForce)
+		{
+			INC_DWORD_STAT(STAT_CombatRagdollsRefused);
+			return false;
+		}
+
+		// make room by putting the oldest simulating ragdoll to sleep. It's frozen on the usual delay
+		for (FRagdoll& Ragdoll : Ragdolls)
+		{
+			USkeletalMeshComponent* OldMesh = Ragdoll.Mesh.Get();
+
+			if (Ragdoll.Phase == ERagdollPhase::Simulating && OldMesh)
+			{
+				OldMesh->PutAllRigidBodiesToSleep();
+				Ragdoll.Phase = ERagdollPhase::Sleeping;
+				break;
+			}
+		}
+	}
+
+	// a full ragdoll replaces any partial one
+	PartialRagdolls.RemoveAll([Mesh](const FPartialRagdoll& Partial) { return Partial.Mesh.Get() == Mesh; });
+
+	Mesh->SetSimulatePhysics(true);
+
+	FRagdoll& Ragdoll = Ragdolls.AddDefaulted_GetRef();
+	Ragdoll.Mesh = Mesh;
+
+	return true;
+}
+
+bool UCombatRagdollSubsystem::RequestPartialRagdoll(USkeletalMeshComponent* Mesh, const FName PinnedBoneName, const float BlendWeight)
+{
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	// refresh an existing partial ragdoll instead of adding another
+	for (FPartialRagdoll& Partial : PartialRagdolls)
+	{
+		if (Partial.Mesh.Get() == Mesh)
+		{
+			Partial.Age = 0.0f;
+			Mesh->SetPhysicsBlendWeight(BlendWeight);
+			return true;
+		}
+	}
+
+	if (PartialRagdolls.Num() >= MaxPartialRagdolls)
+	{
+		INC_DWORD_STAT(STAT_CombatRagdollsRefused);
+		return false;
+	}
+
+	// enable partial ragdoll physics, but keep the pinned bone animated
+	Mesh->SetPhysicsBlendWeight(BlendWeight);
+	Mesh->SetBodySimulatePhysics(PinnedBoneName, false);
+
+	FPartialRagdoll& Partial = PartialRagdolls.AddDefaulted_GetRef();
+	Partial.Mesh = Mesh;
+
+	return true;
+}
+
+void UCombatRagdollSubsystem::FreezePoseAfter(USkeletalMeshComponent* Mesh, const float Delay)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	FPoseFreeze& Freeze = PoseFreezes.AddDefaulted_GetRef();
+	Freeze.Mesh = Mesh;
+	Freeze.TimeLeft = Delay;
+}
+
+void UCombatRagdollSubsystem::EndPartialRagdoll(USkeletalMeshComponent* Mesh)
+{
+	const int32 NumRemoved = PartialRagdolls.RemoveAll([Mesh](const FPartialRagdoll& Partial) { return Partial.Mesh.Get() == Mesh; });
+
+	if (NumRemoved > 0 && Mesh)
+	{
+		Mesh->SetPhysicsBlendWeight(0.0f);
+	}
+}
+
+void UCombatRagdollSubsystem::ReleaseRagdoll(USkeletalMeshComponent* Mesh)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	Ragdolls.RemoveAll([Mesh](const FRagdoll& Ragdoll) { return Ragdoll.Mesh.Get() == Mesh; });
+	PartialRagdolls.RemoveAll([Mesh](const FPartialRagdoll& Partial) { return Partial.Mesh.Get() == Mesh; });
+	PoseFreezes.RemoveAll([Mesh](const FPoseFreeze& Freeze) { return Freeze.Mesh.Get() == Mesh; });
+
+	// undo the freeze and the physics
+	Mesh->bNoSkeletonUpdate = false;
+	Mesh->SetComponentTickEnabled(true);
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetPhysicsBlendWeight(0.0f);
+}
+
+bool UCombatRagdollSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatRagdollSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatRagdollBudget);
+
+	const float SettledSpeedSquared = FMath::Square(SettledSpeed);
+
+	int32 NumSimulating = 0;
+	int32 NumSimulatingBodies = 0;
+	int32 NumFrozen = 0;
+
+	for (int32 i = Ragdolls.Num() - 1; i >= 0; --i)
+	{
+		FRagdoll& Ragdoll = Ragdolls[i];
+		USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get();
+
+		// drop destroyed meshes, and meshes something else took out of simulation
+		if (!Mesh || (Ragdoll.Phase == ERagdollPhase::Simulating && !Mesh->IsSimulatingPhysics()))
+		{
+			Ragdolls.RemoveAt(i);
+			continue;
+		}
+
+		Ragdoll.Age += DeltaTime;
+
+		switch (Ragdoll.Phase)
+		{
+		case ERagdollPhase::Simulating:
+
+			// wait for the root body to settle
+			Ragdoll.SettledAge = Mesh->GetPhysicsLinearVelocity().SizeSquared() <= SettledSpeedSquared ? Ragdoll.SettledAge + DeltaTime : 0.0f;
+
+			if (Ragdoll.SettledAge >= SettleTime || Ragdoll.Age >= MaxSimulationTime)
+			{
+				Mesh->PutAllRigidBodiesToSleep();
+				Ragdoll.Phase = ERagdollPhase::Sleeping;
+
+			} else {
+
+				++NumSimulating;
+				NumSimulatingBodies += Mesh->Bodies.Num();
+			}
+
+			break;
+
+		case ERagdollPhase::Sleeping:
+
+			Ragdoll.SleepAge += DeltaTime;
+
+			if (Ragdoll.SleepAge >= FreezeDelay)
+			{
+				FreezeRagdoll(Mesh);
+				Ragdoll.Phase = ERagdollPhase::Frozen;
+			}
+
+			break;
+
+		case ERagdollPhase::Frozen:
+
+			++NumFrozen;
+			break;
+		}
+	}
+
+	// expire partial ragdolls whose owners never landed
+	for (int32 i = PartialRagdolls.Num() - 1; i >= 0; --i)
+	{
+		FPartialRagdoll& Partial = PartialRagdolls[i];
+		Partial.Age += DeltaTime;
+
+		if (!Partial.Mesh.IsValid() || Partial.Age >= MaxPartialRagdollTime)
+		{
+			if (USkeletalMeshComponent* Mesh = Partial.Mesh.Get())
+			{
+				Mesh->SetPhysicsBlendWeight(0.0f);
+			}
+
+			PartialRagdolls.RemoveAt(i);
+		}
+	}
+
+	// freeze animated deaths once they reach their last frame
+	for (int32 i = PoseFreezes.Num() - 1; i >= 0; --i)
+	{
+		FPoseFreeze& Freeze = PoseFreezes[i];
+		Freeze.TimeLeft -= DeltaTime;
+
+		if (!Freeze.Mesh.IsValid() || Freeze.TimeLeft <= 0.0f)
+		{
+			if (USkeletalMeshComponent* Mesh = Freeze.Mesh.Get())
+			{
+				FreezeRagdoll(Mesh);
+			}
+
+			PoseFreezes.RemoveAt(i);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CombatSimulatingRagdolls, NumSimulating);
+	SET_DWORD_STAT(STAT_CombatSimulatingRagdollBodies, NumSimulatingBodies);
+	SET_DWORD_STAT(STAT_CombatFrozenRagdolls, NumFrozen);
+	SET_DWORD_STAT(STAT_CombatPartialRagdolls, PartialRagdolls.Num());
+}
+
+TStatId UCombatRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatRagdollSubsystem, STATGROUP_Tickables);
+}
+
+int32 UCombatRagdollSubsystem::GetNumSimulating() const
+{
+	int32 NumSimulating = 0;
+
+	for (const FRagdoll& Ragdoll : Ragdolls)
+	{
+		if (Ragdoll.Phase == ERagdollPhase::Simulating && Ragdoll.Mesh.IsValid())
+		{
+			++NumSimulating;
+		}
+	}
+
+	return NumSimulating;
+}
+
+void UCombatRagdollSubsystem::FreezeRagdoll(USkeletalMeshComponent* Mesh)
+{
+	// stop refreshing bones first, so the last simulated pose is kept once physics is off
+	Mesh->bNoSkeletonUpdate = true;
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetComponentTickEnabled(false);
+}
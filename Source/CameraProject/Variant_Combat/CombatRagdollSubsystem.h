@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatRagdollSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ *  World subsystem that budgets simulated skeletons for combat deaths and hit reactions.
+ *  Full ragdolls are capped. Over budget, a death request is refused so the caller can fall back to an animated death pose,
+ *  which is frozen on its last frame. Forced requests put the oldest simulating ragdoll to sleep to stay within the cap.
+ *  Granted ragdolls are put to sleep as soon as they settle, or after a time limit,
+ *  then frozen to a static pose so they stop costing physics and bone updates entirely.
+ *  Partial ragdolls used by hit reactions have their own cap, and are released on landing or after a time limit.
+ */
+UCLASS(Config=Game)
+class UCombatRagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Max number of full ragdolls simulating at once. Frozen ragdolls don't count */
+	UPROPERTY(Config)
+	int32 MaxSimulatedRagdolls = 4;
+
+	/** Max number of partial hit reaction ragdolls at once */
+	UPROPERTY(Config)
+	int32 MaxPartialRagdolls = 4;
+
+	/** Root body speed below which a ragdoll counts as settled */
+	UPROPERTY(Config)
+	float SettledSpeed = 10.0f;
+
+	/** Time a ragdoll must stay settled before it's put to sleep */
+	UPROPERTY(Config)
+	float SettleTime = 0.5f;
+
+	/** Max time a ragdoll simulates before it's put to sleep, settled or not */
+	UPROPERTY(Config)
+	float MaxSimulationTime = 4.0f;
+
+	/** Time a sleeping ragdoll waits before it's frozen to a static pose */
+	UPROPERTY(Config)
+	float FreezeDelay = 0.5f;
+
+	/** Max time a partial ragdoll lasts if its owner never lands */
+	UPROPERTY(Config)
+	float MaxPartialRagdollTime = 2.0f;
+
+	/** Phase of a tracked full ragdoll */
+	enum class ERagdollPhase : uint8
+	{
+		Simulating,
+		Sleeping,
+		Frozen
+	};
+
+	/** A tracked full ragdoll */
+	struct FRagdoll
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		ERagdollPhase Phase = ERagdollPhase::Simulating;
+		float Age = 0.0f;
+		float SettledAge = 0.0f;
+		float SleepAge = 0.0f;
+	};
+
+	/** A tracked partial ragdoll */
+	struct FPartialRagdoll
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		float Age = 0.0f;
+	};
+
+	/** An animated death waiting to be frozen on its last frame */
+	struct FPoseFreeze
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		float TimeLeft = 0.0f;
+	};
+
+	/** Full ragdolls, oldest first */
+	TArray<FRagdoll> Ragdolls;
+
+	/** Partial ragdolls, oldest first */
+	TArray<FPartialRagdoll> PartialRagdolls;
+
+	/** Animated deaths waiting to be frozen */
+	TArray<FPoseFreeze> PoseFreezes;
+
+public:
+
+	/**
+	 *  Starts a full ragdoll on the mesh if the budget allows it.
+	 *  Returns false if over budget, so the caller can play an animated death instead.
+	 *  Forced requests always start, putting the oldest simulating ragdoll to sleep if over budget.
+	 */
+	bool RequestRagdoll(USkeletalMeshComponent* Mesh, bool bForce = false);
+
+	/** Starts a partial ragdoll on the mesh with the pinned bone kept animated. Returns false if over budget */
+	bool RequestPartialRagdoll(USkeletalMeshComponent* Mesh, FName PinnedBoneName, float BlendWeight);
+
+	/** Freezes the mesh on its current pose after the delay. Used to hold the last frame of an animated death before it blends out */
+	void FreezePoseAfter(USkeletalMeshComponent* Mesh, float Delay);
+
+	/** Ends the mesh's partial ragdoll, if it has one */
+	void EndPartialRagdoll(USkeletalMeshComponent* Mesh);
+
+	/** Stops tracking the mesh, unfreezes it and turns its physics off */
+	void ReleaseRagdoll(USkeletalMeshComponent* Mesh);
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Sleeps, freezes and expires the tracked ragdolls and animated deaths */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Returns the number of full ragdolls still simulating */
+	int32 GetNumSimulating() const;
+
+	/** Freezes a ragdoll to its current pose */
+	static void FreezeRagdoll(USkeletalMeshComponent* Mesh);
+};
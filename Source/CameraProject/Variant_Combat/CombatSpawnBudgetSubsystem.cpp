@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatSpawnBudgetSubsystem.h"
+#include "CombatEnemySpawner.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/PlatformTime.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Budget"), STAT_CombatSpawnBudget, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budgeted Spawns"), STAT_CombatBudgetedSpawns, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawn Queue Depth"), STAT_CombatSpawnQueueDepth, STATGROUP_CameraProject);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Spawn Budget Used (ms)"), STAT_CombatSpawnBudgetUsed, STATGROUP_CameraProject);
+
+void UCombatSpawnBudgetSubsystem::RequestSpawn(ACombatEnemySpawner* Spawner, const bool bPrewarm)
+{
+	if (!Spawner)
+	{
+		return;
+	}
+
+	FSpawnRequest& Request = Queue.AddDefaulted_GetRef();
+	Request.Spawner = Spawner;
+	Request.Sequence = NextSequence++;
+	Request.bPrewarm = bPrewarm;
+}
+
+void UCombatSpawnBudgetSubsystem::CancelSpawns(const ACombatEnemySpawner* Spawner)
+{
+	Queue.RemoveAll([Spawner](const FSpawnRequest& Request) { return Request.Spawner.Get() == Spawner; });
+}
+
+bool UCombatSpawnBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSpawnBudgetSubsystem::Tick(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_CombatSpawnQueueDepth, Queue.Num());
+
+	if (Queue.IsEmpty())
+	{
+		SET_FLOAT_STAT(STAT_CombatSpawnBudgetUsed, 0.0f);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatSpawnBudget);
+
+	UWorld* World = GetWorld();
+
+	// gather the player pawn locations
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	// prioritize wave spawns over prewarms, then by distance to the closest player. Requests from one spawner share a distance, so they stay in queue order
+	for (FSpawnRequest& Request : Queue)
+	{
+		Request.DistanceSquared = 0.0;
+
+		if (const ACombatEnemySpawner* Spawner = Request.Spawner.Get())
+		{
+			Request.DistanceSquared = TNumericLimits<double>::Max();
+
+			for (const FVector& PlayerLocation : PlayerLocations)
+			{
+				Request.DistanceSquared = FMath::Min(Request.DistanceSquared, FVector::DistSquared(Spawner->GetActorLocation(), PlayerLocation));
+			}
+		}
+	}
+
+	Queue.Sort([](const FSpawnRequest& A, const FSpawnRequest& B)
+	{
+		if (A.bPrewarm != B.bPrewarm)
+		{
+			return B.bPrewarm;
+		}
+
+		return A.DistanceSquared != B.DistanceSquared ? A.DistanceSquared < B.DistanceSquared : A.Sequence < B.Sequence;
+	});
+
+	// run spawns until either budget runs out
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumSpawned = 0;
+	int32 NumProcessed = 0;
+
+	while (NumProcessed < Queue.Num())
+	{
+		if (NumSpawned >= MaxSpawnsPerFrame || (NumSpawned > 0 && (FPlatformTime::Seconds() - StartTime) * 1000.0 >= SpawnBudgetMs))
+		{
+			break;
+		}
+
+		// copy the request out, the spawn may queue new requests
+		const FSpawnRequest& Request = Queue[NumProcessed++];
+		ACombatEnemySpawner* Spawner = Request.Spawner.Get();
+		const bool bPrewarm = Request.bPrewarm;
+
+		if (!Spawner)
+		{
+			continue;
+		}
+
+		if (bPrewarm)
+		{
+			Spawner->PrewarmEnemy();
+
+		} else {
+
+			Spawner->SpawnEnemy();
+		}
+
+		++NumSpawned;
+		INC_DWORD_STAT(STAT_CombatBudgetedSpawns);
+	}
+
+	// processed requests are the front of the sorted queue
+	Queue.RemoveAt(0, NumProcessed);
+
+	SET_FLOAT_STAT(STAT_CombatSpawnBudgetUsed, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+TStatId UCombatSpawnBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSpawnBudgetSubsystem, STATGROUP_Tickables);
+}
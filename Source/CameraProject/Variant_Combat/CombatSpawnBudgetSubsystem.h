@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpawnBudgetSubsystem.generated.h"
+
+class ACombatEnemySpawner;
+
+/**
+ *  World subsystem that schedules enemy spawns from every combat spawner under one frame budget.
+ *  Spawners queue requests here instead of spawning from their timers, so several spawners firing on the same frame
+ *  are spread over the following frames. Each frame, requests closest to a player go first, limited both by count and by time.
+ *  Requests from the same spawner always run in the order they were queued.
+ *  Prewarm requests fill a spawner's pool ahead of its waves. They share the budget but only run once no wave spawn is waiting.
+ */
+UCLASS(Config=Game)
+class UCombatSpawnBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Max number of spawns per frame */
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 1;
+
+	/** Time budget for spawns per frame. At least one spawn runs each frame, so the queue always drains */
+	UPROPERTY(Config)
+	float SpawnBudgetMs = 2.0f;
+
+	/** A queued spawn */
+	struct FSpawnRequest
+	{
+		TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+		uint32 Sequence = 0;
+		double DistanceSquared = 0.0;
+
+		/** Spawns straight into the spawner's pool */
+		bool bPrewarm = false;
+	};
+
+	/** Spawns waiting for budget */
+	TArray<FSpawnRequest> Queue;
+
+	/** Incremented for every request, to keep queue order among requests at the same distance */
+	uint32 NextSequence = 0;
+
+public:
+
+	/** Queues a spawn for the spawner. The spawner's SpawnEnemy, or PrewarmEnemy for prewarm requests, is called once the request fits in a frame's budget */
+	void RequestSpawn(ACombatEnemySpawner* Spawner, bool bPrewarm = false);
+
+	/** Drops every queued request from the spawner */
+	void CancelSpawns(const ACombatEnemySpawner* Spawner);
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Runs the queued spawns that fit in this frame's budget */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+};
@@ -22,6 +22,44 @@ ACombatActivationVolume::ACombatActivationVolume()
 
 	// bind the begin overlap 
 	Box->OnComponentBeginOverlap.AddDynamic(this, &ACombatActivationVolume::OnOverlap);
+
+	// create the preload box. It's sized on BeginPlay
+	PreloadBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Preload Box"));
+	PreloadBox->SetupAttachment(RootComponent);
+	PreloadBox->SetCollisionProfileName(FName("OverlapAllDynamic"));
+
+	PreloadBox->OnComponentBeginOverlap.AddDynamic(this, &ACombatActivationVolume::OnPreloadOverlap);
+}
+
+void ACombatActivationVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// grow the preload box past the volume by the margin, in world units
+	const FVector Scale = GetActorScale3D().GetAbs().ComponentMax(FVector(UE_KINDA_SMALL_NUMBER));
+	PreloadBox->SetBoxExtent(Box->GetUnscaledBoxExtent() + FVector(PreloadMargin) / Scale);
+}
+
+void ACombatActivationVolume::OnPreloadOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// only prepare once, for player controlled characters
+	ACharacter* PlayerCharacter = Cast<ACharacter>(OtherActor);
+
+	if (bHasPrepared || !PlayerCharacter || !PlayerCharacter->IsPlayerControlled())
+	{
+		return;
+	}
+
+	bHasPrepared = true;
+
+	// let the actors start loading ahead of activation
+	for (AActor* CurrentActor : ActorsToActivate)
+	{
+		if (ICombatActivatable* Activatable = Cast<ICombatActivatable>(CurrentActor))
+		{
+			Activatable->PrepareInteraction(PlayerCharacter);
+		}
+	}
 }
 
 void ACombatActivationVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -10,6 +10,7 @@ class UBoxComponent;
 
 /**
  *  A simple volume that activates a list of actors when the player pawn enters.
+ *  A larger preload box around it lets the actors prepare ahead of activation, e.g. to load their assets.
  */
 UCLASS()
 class ACombatActivationVolume : public AActor
@@ -19,6 +20,10 @@ class ACombatActivationVolume : public AActor
 	/** Collision box volume */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
 	UBoxComponent* Box;
+
+	/** Box around the volume that prepares the actors when entered */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* PreloadBox;
 	
 protected:
 
@@ -26,6 +31,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Activation Volume")
 	TArray<AActor*> ActorsToActivate;
 
+	/** Distance around the volume at which the actors are prepared for activation */
+	UPROPERTY(EditAnywhere, Category="Activation Volume", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm"))
+	float PreloadMargin = 2000.0f;
+
+	/** Flag to ensure the actors are only prepared once */
+	bool bHasPrepared = false;
+
 public:	
 	
 	/** Constructor */
@@ -33,6 +45,13 @@ public:
 
 protected:
 
+	/** Sizes the preload box around the volume */
+	virtual void BeginPlay() override;
+
+	/** Handles overlaps with the preload box */
+	UFUNCTION()
+	void OnPreloadOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
 	/** Handles overlaps with the box volume */
 	UFUNCTION()
 	void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -4,6 +4,8 @@
 #include "CombatLavaFloor.h"
 #include "CombatDamageable.h"
 #include "Components/StaticMeshComponent.h"
+#include "CombatDamageSubsystem.h"
+#include "Engine/World.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -19,9 +21,12 @@ ACombatLavaFloor::ACombatLavaFloor()
 void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
 	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	if (Cast<ICombatDamageable>(OtherActor))
 	{
-		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		// queue damage for the actor. Hits come in during physics, so it's applied with the rest of the frame's damage
+		if (UCombatDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UCombatDamageSubsystem>())
+		{
+			DamageSubsystem->QueueDamage(OtherActor, Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		}
 	}
 }
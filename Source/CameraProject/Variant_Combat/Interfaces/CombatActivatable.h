@@ -33,4 +33,7 @@ public:
 	/** Deactivates the Interactable Actor */
 	UFUNCTION(BlueprintCallable, Category="Activatable")
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) = 0;
+
+	/** Called when activation is likely to happen soon, so the actor can start loading what it needs */
+	virtual void PrepareInteraction(AActor* ActivationInstigator) {}
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
+#include "Engine/HitResult.h"
 #include "CombatAttacker.generated.h"
 
 /**
@@ -22,10 +23,13 @@ class ICombatAttacker
 
 public:
 
-	/** Performs an attack's collision check. Usually called from a montage's AnimNotify */
+	/** Queues an attack's collision check. Usually called from a montage's AnimNotify. Hits are applied through ApplyAttackHit */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void DoAttackTrace(FName DamageSourceBone) = 0;
 
+	/** Applies a resolved hit from this attacker's attack trace. Called by the melee resolution queue */
+	virtual void ApplyAttackHit(const FHitResult& Hit) = 0;
+
 	/** Performs a combo attack's check to continue the string. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckCombo() = 0;
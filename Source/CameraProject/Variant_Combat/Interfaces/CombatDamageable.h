@@ -23,7 +23,7 @@ class ICombatDamageable
 
 public:
 
-	/** Handles damage and knockback events */
+	/** Handles damage and knockback events. Gameplay damage should be queued with UCombatDamageSubsystem, which calls this once per target per flush */
 	UFUNCTION(BlueprintCallable, Category="Damageable")
 	virtual void ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse) = 0;
 
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLifeBarComponent.h"
+#include "CombatLifeBarSubsystem.h"
+#include "Engine/World.h"
+
+UCombatLifeBarComponent::UCombatLifeBarComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// float above a default sized character capsule
+	SetRelativeLocation(FVector(0.0f, 0.0f, 110.0f));
+}
+
+void UCombatLifeBarComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		BarHandle = LifeBars->RegisterBar(this);
+	}
+}
+
+void UCombatLifeBarComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->UnregisterBar(BarHandle);
+	}
+
+	BarHandle = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCombatLifeBarComponent::SetLifePercentage(const float Percent)
+{
+	const float NewPercentage = FMath::Clamp(Percent, 0.0f, 1.0f);
+
+	if (NewPercentage != LifePercentage)
+	{
+		LifePercentage = NewPercentage;
+		MarkDirty();
+	}
+}
+
+void UCombatLifeBarComponent::SetBarColor(const FLinearColor Color)
+{
+	if (Color != BarColor)
+	{
+		BarColor = Color;
+		MarkDirty();
+	}
+}
+
+void UCombatLifeBarComponent::MarkDirty() const
+{
+	// nothing to tell the subsystem until we're registered
+	if (BarHandle == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+	{
+		LifeBars->MarkBarDirty();
+	}
+}
+
+void UCombatLifeBarComponent::OnVisibilityChanged()
+{
+	Super::OnVisibilityChanged();
+
+	MarkDirty();
+}
+
+void UCombatLifeBarComponent::OnHiddenInGameChanged()
+{
+	Super::OnHiddenInGameChanged();
+
+	MarkDirty();
+}
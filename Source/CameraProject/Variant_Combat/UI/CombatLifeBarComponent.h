@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "CombatLifeBarComponent.generated.h"
+
+/**
+ *  Marks where an actor's life bar is drawn and holds its fill and color.
+ *  It has no widget of its own: UCombatLifeBarSubsystem draws every registered bar in one shared screen space layer.
+ *  Hide the bar with SetHiddenInGame, or by hiding the owning actor.
+ *  Changes are pushed to the subsystem, so an unchanged bar costs nothing until it needs to be drawn.
+ */
+UCLASS(ClassGroup=Combat, meta=(BlueprintSpawnableComponent))
+class UCombatLifeBarComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Bar fill color */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	FLinearColor BarColor = FLinearColor::Red;
+
+	/** If true, the bar isn't drawn while the life bar is full */
+	UPROPERTY(EditAnywhere, Category="Life Bar")
+	bool bHideWhenFull = true;
+
+	/** Current fill, 0 to 1 */
+	float LifePercentage = 1.0f;
+
+	/** Handle of this bar in the life bar subsystem */
+	int32 BarHandle = INDEX_NONE;
+
+	/** Lets the life bar subsystem know this bar changed */
+	void MarkDirty() const;
+
+	/** Visibility changes may show or hide the bar */
+	virtual void OnVisibilityChanged() override;
+
+	/** Visibility changes may show or hide the bar */
+	virtual void OnHiddenInGameChanged() override;
+
+public:
+
+	/** Constructor */
+	UCombatLifeBarComponent();
+
+	/** Registers the bar with the life bar subsystem */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the bar */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Sets the life bar to the provided 0-1 percentage value */
+	UFUNCTION(BlueprintCallable, Category="Life Bar")
+	void SetLifePercentage(float Percent);
+
+	/** Sets the life bar fill color */
+	UFUNCTION(BlueprintCallable, Category="Life Bar")
+	void SetBarColor(FLinearColor Color);
+
+	/** Sets whether the bar is skipped while full */
+	void SetHideWhenFull(bool bHide) { bHideWhenFull = bHide; }
+
+	/** Returns the current fill */
+	float GetLifePercentage() const { return LifePercentage; }
+
+	/** Returns the fill color */
+	const FLinearColor& GetBarColor() const { return BarColor; }
+
+	/** Returns true if the bar should be skipped while full */
+	bool ShouldHideWhenFull() const { return bHideWhenFull; }
+};
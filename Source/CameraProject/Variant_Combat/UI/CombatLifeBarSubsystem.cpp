@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatLifeBarSubsystem.h"
+#include "CombatLifeBarComponent.h"
+#include "SCombatLifeBarLayer.h"
+#include "Engine/World.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "CameraProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Life Bar Layer Update"), STAT_CombatLifeBarUpdate, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Life Bars Drawn"), STAT_CombatLifeBarsDrawn, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Life Bars Live"), STAT_CombatLifeBarsLive, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Life Bars Culled"), STAT_CombatLifeBarsCulled, STATGROUP_CameraProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Life Bar List Rebuilds"), STAT_CombatLifeBarRebuilds, STATGROUP_CameraProject);
+
+int32 UCombatLifeBarSubsystem::RegisterBar(UCombatLifeBarComponent* Bar)
+{
+	if (!Bar)
+	{
+		return INDEX_NONE;
+	}
+
+	bActiveBarsDirty = true;
+	return Bars.Add(Bar);
+}
+
+void UCombatLifeBarSubsystem::UnregisterBar(const int32 Handle)
+{
+	if (Bars.IsValidIndex(Handle))
+	{
+		Bars.RemoveAt(Handle);
+		bActiveBarsDirty = true;
+	}
+}
+
+void UCombatLifeBarSubsystem::Deinitialize()
+{
+	for (const FLayer& Layer : Layers)
+	{
+		if (ULocalPlayer* LocalPlayer = Layer.LocalPlayer.Get(); LocalPlayer && LocalPlayer->ViewportClient && Layer.Widget.IsValid())
+		{
+			LocalPlayer->ViewportClient->RemoveViewportWidgetForPlayer(LocalPlayer, Layer.Widget.ToSharedRef());
+		}
+	}
+
+	Layers.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UCombatLifeBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatLifeBarSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatLifeBarUpdate);
+
+	if (bActiveBarsDirty)
+	{
+		RebuildActiveBars();
+	}
+
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+
+	// cull the active bars whose owners are hidden or weren't rendered recently, before paying for any projection
+	TArray<const UCombatLifeBarComponent*> Candidates;
+	Candidates.Reserve(ActiveBars.Num());
+
+	for (const TWeakObjectPtr<UCombatLifeBarComponent>& WeakBar : ActiveBars)
+	{
+		const UCombatLifeBarComponent* Bar = WeakBar.Get();
+		const AActor* Owner = Bar ? Bar->GetOwner() : nullptr;
+
+		if (!Owner || Owner->IsHidden())
+		{
+			continue;
+		}
+
+		if (WorldTime - Owner->GetLastRenderTime() > RenderedTolerance)
+		{
+			continue;
+		}
+
+		Candidates.Add(Bar);
+	}
+
+	const double MaxDrawDistanceSquared = MaxDrawDistance > 0.0f ? FMath::Square(MaxDrawDistance) : TNumericLimits<double>::Max();
+
+	int32 NumDrawn = 0;
+	TArray<FCombatLifeBarDrawData> DrawData;
+	DrawData.Reserve(Candidates.Num());
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+
+		if (!LocalPlayer || !LocalPlayer->ViewportClient)
+		{
+			continue;
+		}
+
+		SCombatLifeBarLayer* Layer = FindOrAddLayer(LocalPlayer);
+		DrawData.Reset();
+
+		// build the view projection once and project every bar with it
+		FSceneViewProjectionData ProjectionData;
+
+		if (Candidates.Num() > 0 && LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+		{
+			const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+			const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+			const FVector ViewOrigin = ProjectionData.ViewOrigin;
+
+			for (const UCombatLifeBarComponent* Bar : Candidates)
+			{
+				const FVector BarLocation = Bar->GetComponentLocation();
+
+				// skip distant bars
+				if (FVector::DistSquared(BarLocation, ViewOrigin) > MaxDrawDistanceSquared)
+				{
+					continue;
+				}
+
+				FVector2D ScreenPosition;
+
+				// skip bars behind the camera or outside the view
+				if (!FSceneView::ProjectWorldToScreen(BarLocation, ViewRect, ViewProjectionMatrix, ScreenPosition) || !ViewRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y)))
+				{
+					continue;
+				}
+
+				FCombatLifeBarDrawData& Data = DrawData.AddDefaulted_GetRef();
+				Data.Position = FVector2f(ScreenPosition - FVector2D(ViewRect.Min));
+				Data.Fraction = Bar->GetLifePercentage();
+				Data.Color = Bar->GetBarColor();
+			}
+		}
+
+		Layer->SetBars(DrawData);
+
+		// collapse empty layers so Slate doesn't visit them at all
+		Layer->SetVisibility(DrawData.IsEmpty() ? EVisibility::Collapsed : EVisibility::HitTestInvisible);
+
+		NumDrawn += DrawData.Num();
+	}
+
+	SET_DWORD_STAT(STAT_CombatLifeBarsDrawn, NumDrawn);
+	SET_DWORD_STAT(STAT_CombatLifeBarsLive, ActiveBars.Num());
+	SET_DWORD_STAT(STAT_CombatLifeBarsCulled, FMath::Max(0, Bars.Num() - NumDrawn));
+}
+
+TStatId UCombatLifeBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatLifeBarSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatLifeBarSubsystem::RebuildActiveBars()
+{
+	INC_DWORD_STAT(STAT_CombatLifeBarRebuilds);
+
+	bActiveBarsDirty = false;
+	ActiveBars.Reset();
+
+	for (const TWeakObjectPtr<UCombatLifeBarComponent>& WeakBar : Bars)
+	{
+		const UCombatLifeBarComponent* Bar = WeakBar.Get();
+
+		if (!Bar || !Bar->IsVisible())
+		{
+			continue;
+		}
+
+		// full bars aren't worth drawing
+		if (Bar->ShouldHideWhenFull() && Bar->GetLifePercentage() >= 1.0f)
+		{
+			continue;
+		}
+
+		ActiveBars.Add(WeakBar);
+	}
+}
+
+SCombatLifeBarLayer* UCombatLifeBarSubsystem::FindOrAddLayer(ULocalPlayer* LocalPlayer)
+{
+	for (const FLayer& Layer : Layers)
+	{
+		if (Layer.LocalPlayer.Get() == LocalPlayer)
+		{
+			return Layer.Widget.Get();
+		}
+	}
+
+	// create the overlay the first time we have a local player to show it to
+	FLayer& Layer = Layers.AddDefaulted_GetRef();
+	Layer.LocalPlayer = LocalPlayer;
+	Layer.Widget = SNew(SCombatLifeBarLayer);
+
+	LocalPlayer->ViewportClient->AddViewportWidgetForPlayer(LocalPlayer, Layer.Widget.ToSharedRef(), 0);
+
+	return Layer.Widget.Get();
+}
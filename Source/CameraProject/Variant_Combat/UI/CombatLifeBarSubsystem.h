@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatLifeBarSubsystem.generated.h"
+
+class UCombatLifeBarComponent;
+class ULocalPlayer;
+class SCombatLifeBarLayer;
+
+/**
+ *  World subsystem that draws every combat life bar through one native Slate layer per local player.
+ *  Once per frame it projects the registered bars with a single view projection per player,
+ *  culls hidden, full and off-screen bars, and hands the rest to the layer as one compact array.
+ *  This replaces a widget component, render target and widget tree per character.
+ *
+ *  Bars push their changes here: the list of bars worth drawing is only rebuilt when a bar's HP, color or visibility changes.
+ *  Each frame only that list is culled by distance and by whether its owner was rendered, and the layer only repaints
+ *  when what it shows actually changed. A layer with nothing to show is collapsed so Slate skips it.
+ */
+UCLASS(Config=Game)
+class UCombatLifeBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Bars further than this from the view are culled. Zero or less to disable */
+	UPROPERTY(Config)
+	float MaxDrawDistance = 3000.0f;
+
+	/** Bars whose owner wasn't rendered within this time are culled without being projected */
+	UPROPERTY(Config)
+	float RenderedTolerance = 0.2f;
+
+	/** Registered bars. Handles are indices into this array */
+	TSparseArray<TWeakObjectPtr<UCombatLifeBarComponent>> Bars;
+
+	/** Registered bars that are visible and not hidden by being full. Rebuilt when a bar is marked dirty */
+	TArray<TWeakObjectPtr<UCombatLifeBarComponent>> ActiveBars;
+
+	/** Set when a bar changed in a way that may add it to or remove it from the active bars */
+	bool bActiveBarsDirty = false;
+
+	/** Life bar layer shown to a local player */
+	struct FLayer
+	{
+		TWeakObjectPtr<ULocalPlayer> LocalPlayer;
+		TSharedPtr<SCombatLifeBarLayer> Widget;
+	};
+
+	/** Layers, one per local player */
+	TArray<FLayer> Layers;
+
+public:
+
+	/** Registers a bar and returns its handle */
+	int32 RegisterBar(UCombatLifeBarComponent* Bar);
+
+	/** Unregisters a bar by handle */
+	void UnregisterBar(int32 Handle);
+
+	/** Called by a bar when its HP, color or visibility changes */
+	void MarkBarDirty() { bActiveBarsDirty = true; }
+
+	/** Removes the layers from the viewport */
+	virtual void Deinitialize() override;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Projects and culls the bars, then updates every local player's layer */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat id for the tick */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Rebuilds the list of bars worth drawing */
+	void RebuildActiveBars();
+
+	/** Returns the layer for a local player, creating it on first use */
+	SCombatLifeBarLayer* FindOrAddLayer(ULocalPlayer* LocalPlayer);
+};
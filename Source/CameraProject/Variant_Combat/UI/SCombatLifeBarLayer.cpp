@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SCombatLifeBarLayer.h"
+#include "Rendering/DrawElements.h"
+
+namespace CombatLifeBarLayer
+{
+	/** Movement below this many pixels doesn't trigger a repaint */
+	constexpr float InvalidationThresholdPixels = 1.0f;
+}
+
+void SCombatLifeBarLayer::Construct(const FArguments& InArgs)
+{
+	BarSize = InArgs._BarSize;
+	BackgroundColor = InArgs._BackgroundColor;
+}
+
+void SCombatLifeBarLayer::SetBars(TConstArrayView<FCombatLifeBarDrawData> NewBars)
+{
+	// check if anything changed enough to be visible
+	bool bChanged = NewBars.Num() != Bars.Num();
+	for (int32 Index = 0; !bChanged && Index < NewBars.Num(); ++Index)
+	{
+		bChanged = NewBars[Index].Fraction != Bars[Index].Fraction
+			|| NewBars[Index].Color != Bars[Index].Color
+			|| FVector2f::DistSquared(NewBars[Index].Position, Bars[Index].Position) > FMath::Square(CombatLifeBarLayer::InvalidationThresholdPixels);
+	}
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	Bars.Reset();
+	Bars.Append(NewBars.GetData(), NewBars.Num());
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SCombatLifeBarLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// bars are in pixels, convert to local slate units
+	const float InverseScale = AllottedGeometry.Scale > 0.0f ? 1.0f / AllottedGeometry.Scale : 1.0f;
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+	// all backgrounds on one layer and all fills on the next, so the bars batch into two draws
+	for (const FCombatLifeBarDrawData& Bar : Bars)
+	{
+		const FVector2f TopLeft = Bar.Position * InverseScale - BarSize * 0.5f;
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.ToPaintGeometry(BarSize, FSlateLayoutTransform(TopLeft)),
+			&WhiteBrush,
+			ESlateDrawEffect::None,
+			BackgroundColor * Tint);
+	}
+
+	for (const FCombatLifeBarDrawData& Bar : Bars)
+	{
+		const FVector2f TopLeft = Bar.Position * InverseScale - BarSize * 0.5f;
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			LayerId + 1,
+			AllottedGeometry.ToPaintGeometry(FVector2f(BarSize.X * Bar.Fraction, BarSize.Y), FSlateLayoutTransform(TopLeft)),
+			&WhiteBrush,
+			ESlateDrawEffect::None,
+			Bar.Color * Tint);
+	}
+
+	return LayerId + 1;
+}
+
+FVector2D SCombatLifeBarLayer::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// the overlay fills whatever space the viewport gives it
+	return FVector2D::ZeroVector;
+}
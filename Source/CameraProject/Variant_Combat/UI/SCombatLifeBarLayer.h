@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Brushes/SlateColorBrush.h"
+
+/** A single life bar drawn by SCombatLifeBarLayer */
+struct FCombatLifeBarDrawData
+{
+	/** Projected bar center relative to the player's view rect, in pixels */
+	FVector2f Position = FVector2f::ZeroVector;
+
+	/** Filled fraction of the bar, 0 to 1 */
+	float Fraction = 1.0f;
+
+	/** Fill color */
+	FLinearColor Color = FLinearColor::White;
+};
+
+/**
+ *  Native Slate overlay that draws every visible combat life bar in one paint pass.
+ *  Bars are pushed in once per frame by UCombatLifeBarSubsystem; the widget only
+ *  invalidates its paint when a bar moves by more than a pixel, changes fill or color, or the bar set changes.
+ */
+class SCombatLifeBarLayer : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SCombatLifeBarLayer)
+		: _BarSize(FVector2f(80.0f, 8.0f))
+		, _BackgroundColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.6f))
+	{
+		_Visibility = EVisibility::HitTestInvisible;
+	}
+		SLATE_ARGUMENT(FVector2f, BarSize)
+		SLATE_ARGUMENT(FLinearColor, BackgroundColor)
+	SLATE_END_ARGS()
+
+	/** Constructs the widget */
+	void Construct(const FArguments& InArgs);
+
+	/** Replaces the bars. Only invalidates paint if something visibly changed */
+	void SetBars(TConstArrayView<FCombatLifeBarDrawData> NewBars);
+
+	// ~begin SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	// ~end SWidget interface
+
+protected:
+
+	/** Bars currently drawn */
+	TArray<FCombatLifeBarDrawData> Bars;
+
+	/** Bar size, in slate units */
+	FVector2f BarSize = FVector2f(80.0f, 8.0f);
+
+	/** Color of the empty part of the bar */
+	FLinearColor BackgroundColor;
+
+	/** Flat brush tinted for both the background and the fill */
+	FSlateColorBrush WhiteBrush = FSlateColorBrush(FLinearColor::White);
+};
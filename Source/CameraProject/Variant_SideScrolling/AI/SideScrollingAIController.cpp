@@ -3,6 +3,8 @@
 
 #include "SideScrollingAIController.h"
 #include "GameplayStateTreeModule/Public/Components/StateTreeAIComponent.h"
+#include "AITickLODSubsystem.h"
+#include "Engine/World.h"
 
 ASideScrollingAIController::ASideScrollingAIController()
 {
@@ -17,3 +19,24 @@ ASideScrollingAIController::ASideScrollingAIController()
 	// this is necessary for EnvQueries to work correctly
 	bAttachToPawn = true;
 }
+
+void ASideScrollingAIController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// tick the StateTree less often when far from the player
+	if (UAITickLODSubsystem* TickLOD = GetWorld()->GetSubsystem<UAITickLODSubsystem>())
+	{
+		TickLOD->RegisterAgent(StateTreeAI);
+	}
+}
+
+void ASideScrollingAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAITickLODSubsystem* TickLOD = GetWorld()->GetSubsystem<UAITickLODSubsystem>())
+	{
+		TickLOD->UnregisterAgent(StateTreeAI);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -5,6 +5,7 @@
 #include "Engine/World.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
+#include "SideScrollingActivationSubsystem.h"
 
 ASideScrollingNPC::ASideScrollingNPC()
 {
@@ -13,10 +14,26 @@ ASideScrollingNPC::ASideScrollingNPC()
 	GetCharacterMovement()->MaxWalkSpeed = 150.0f;
 }
 
+void ASideScrollingNPC::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// sleep while we're outside of the camera window
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->RegisterActor(this);
+	}
+}
+
 void ASideScrollingNPC::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->UnregisterActor(this);
+	}
+
 	// clear the deactivation timer
 	GetWorld()->GetTimerManager().ClearTimer(DeactivationTimer);
 }
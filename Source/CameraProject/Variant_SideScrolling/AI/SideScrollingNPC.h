@@ -47,6 +47,9 @@ public:
 
 public:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
 	/** Cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
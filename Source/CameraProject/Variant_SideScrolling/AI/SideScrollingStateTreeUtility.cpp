@@ -5,22 +5,32 @@
 #include "StateTreeExecutionContext.h"
 #include "StateTreeExecutionTypes.h"
 #include "AIController.h"
-#include "Kismet/GameplayStatics.h"
+#include "AIPlayerInfoSubsystem.h"
+#include "Engine/World.h"
 
 EStateTreeRunStatus FStateTreeGetPlayerTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
 {
 	// get the instance data
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-	// set the player pawn as the target
-	InstanceData.TargetPlayer = UGameplayStatics::GetPlayerPawn(InstanceData.Controller.Get(), 0);
+	// is the NPC valid?
+	if (!IsValid(InstanceData.NPC))
+	{
+		return EStateTreeRunStatus::Running;
+	}
 
-	// are the NPC and target valid?
-	if (IsValid(InstanceData.TargetPlayer) && IsValid(InstanceData.NPC))
+	// set the closest player pawn as the target, using the per-frame player cache
+	const FAIPlayerInfo* Player = nullptr;
+	double Distance = 0.0;
+
+	if (UAIPlayerInfoSubsystem* PlayerInfo = InstanceData.NPC->GetWorld()->GetSubsystem<UAIPlayerInfoSubsystem>())
 	{
-		InstanceData.bValidTarget = FVector::Distance(InstanceData.NPC->GetActorLocation(), InstanceData.TargetPlayer->GetActorLocation()) < InstanceData.RangeMax;
+		Player = PlayerInfo->FindClosestPlayer(InstanceData.NPC->GetActorLocation(), &Distance);
 	}
 
+	InstanceData.TargetPlayer = Player ? Player->Pawn.Get() : nullptr;
+	InstanceData.bValidTarget = IsValid(InstanceData.TargetPlayer) && Distance < InstanceData.RangeMax;
+
 	return EStateTreeRunStatus::Running;
 }
 
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingCameraBounds.h"
+#include "SideScrollingCameraBoundsSubsystem.h"
+#include "Components/BrushComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+
+ASideScrollingCameraBounds::ASideScrollingCameraBounds()
+{
+	// camera bounds are only read by the camera, they never collide
+	GetBrushComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	GetBrushComponent()->SetGenerateOverlapEvents(false);
+}
+
+void ASideScrollingCameraBounds::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// index the volume so the camera can find it
+	if (USideScrollingCameraBoundsSubsystem* Subsystem = GetWorld()->GetSubsystem<USideScrollingCameraBoundsSubsystem>())
+	{
+		Subsystem->RegisterBounds(this);
+	}
+}
+
+void ASideScrollingCameraBounds::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USideScrollingCameraBoundsSubsystem* Subsystem = GetWorld()->GetSubsystem<USideScrollingCameraBoundsSubsystem>())
+	{
+		Subsystem->UnregisterBounds(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FFloatInterval ASideScrollingCameraBounds::GetXRange() const
+{
+	const FBox Bounds = GetBrushComponent()->Bounds.GetBox();
+	return FFloatInterval(Bounds.Min.X, Bounds.Max.X);
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Volume.h"
+#include "SideScrollingCameraBounds.generated.h"
+
+/**
+ *  Placeable section of a side scrolling level with its own camera settings.
+ *  Once the view target enters the volume's X range, the camera view is kept inside that range and uses the volume's Z clamp and zoom,
+ *  until the view target enters a different volume.
+ *  Overlapping volumes are resolved by priority.
+ */
+UCLASS()
+class ASideScrollingCameraBounds : public AVolume
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ASideScrollingCameraBounds();
+
+protected:
+
+	/** Volumes with higher priority win where they overlap */
+	UPROPERTY(EditAnywhere, Category="Camera Bounds")
+	int32 Priority = 0;
+
+	/** If true, the camera height is clamped while in this volume */
+	UPROPERTY(EditAnywhere, Category="Camera Bounds")
+	bool bClampZ = false;
+
+	/** Minimum camera height while in this volume */
+	UPROPERTY(EditAnywhere, Category="Camera Bounds", meta=(EditCondition="bClampZ", ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float MinZ = -1000.0f;
+
+	/** Maximum camera height while in this volume */
+	UPROPERTY(EditAnywhere, Category="Camera Bounds", meta=(EditCondition="bClampZ", ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float MaxZ = 1000.0f;
+
+	/** Camera distance while in this volume. Zero keeps the camera manager's default */
+	UPROPERTY(EditAnywhere, Category="Camera Bounds", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float Zoom = 0.0f;
+
+protected:
+
+	/** Registers the volume with the camera bounds subsystem */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the volume from the camera bounds subsystem */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Returns the X range covered by this volume in world space */
+	FFloatInterval GetXRange() const;
+
+	/** Returns the volume priority */
+	int32 GetPriority() const { return Priority; }
+
+	/** Clamps a camera height to this volume's Z range, if it has one */
+	float ClampZ(float Z) const { return bClampZ ? FMath::Clamp(Z, MinZ, MaxZ) : Z; }
+
+	/** Returns the camera zoom for this volume, or the default if it doesn't override it */
+	float GetZoom(float DefaultZoom) const { return Zoom > 0.0f ? Zoom : DefaultZoom; }
+};
@@ -0,0 +1,239 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingGroundProfile.h"
+#include "SideScrollingMovingPlatform.h"
+#include "Engine/World.h"
+#include "Engine/HitResult.h"
+#include "CollisionQueryParams.h"
+#include "EngineUtils.h"
+
+ASideScrollingGroundProfile::ASideScrollingGroundProfile()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the root comp
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// the profile is only data, it doesn't need to exist in game
+	SetHidden(true);
+	SetCanBeDamaged(false);
+}
+
+void ASideScrollingGroundProfile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// bake now if the level was saved without a profile
+	if (bBakeOnBeginPlay && !HasProfile())
+	{
+		BakeProfile();
+	}
+}
+
+void ASideScrollingGroundProfile::BakeProfile()
+{
+	UWorld* World = GetWorld();
+
+	if (!World || SampleSpacing <= 0.0f || BakeMaxX <= BakeMinX)
+	{
+		return;
+	}
+
+	Modify();
+
+	ProfileMinX = BakeMinX;
+	ProfileSpacing = SampleSpacing;
+
+	const int32 NumSamples = FMath::FloorToInt32((BakeMaxX - BakeMinX) / SampleSpacing) + 1;
+
+	SampleOffsets.Reset(NumSamples + 1);
+	SurfaceHeights.Reset(NumSamples);
+	FallbackSamples.Reset(NumSamples);
+	FallbackSamples.AddZeroed(NumSamples);
+
+	FCollisionQueryParams QueryParams;
+	FlagPlatformSamples(0, NumSamples - 1, QueryParams);
+
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		SampleOffsets.Add(SurfaceHeights.Num());
+
+		if (!TraceSample(Sample, QueryParams, SurfaceHeights))
+		{
+			FallbackSamples[Sample] = 1;
+		}
+	}
+
+	// close the last sample
+	SampleOffsets.Add(SurfaceHeights.Num());
+}
+
+void ASideScrollingGroundProfile::RebakeRange(const float MinX, const float MaxX)
+{
+	if (!HasProfile() || ProfileSpacing <= 0.0f)
+	{
+		return;
+	}
+
+	const int32 NumSamples = SampleOffsets.Num() - 1;
+	const int32 FirstSample = FMath::Max(0, FMath::FloorToInt32((MinX - ProfileMinX) / ProfileSpacing));
+	const int32 LastSample = FMath::Min(NumSamples - 1, FMath::CeilToInt32((MaxX - ProfileMinX) / ProfileSpacing));
+
+	if (FirstSample > LastSample)
+	{
+		return;
+	}
+
+	// re-trace the range on its own
+	for (int32 Sample = FirstSample; Sample <= LastSample; ++Sample)
+	{
+		FallbackSamples[Sample] = 0;
+	}
+
+	FCollisionQueryParams QueryParams;
+	FlagPlatformSamples(FirstSample, LastSample, QueryParams);
+
+	TArray<float> RangeHeights;
+	TArray<int32> RangeCounts;
+	RangeCounts.Reserve(LastSample - FirstSample + 1);
+
+	for (int32 Sample = FirstSample; Sample <= LastSample; ++Sample)
+	{
+		const int32 NumBefore = RangeHeights.Num();
+
+		if (!TraceSample(Sample, QueryParams, RangeHeights))
+		{
+			FallbackSamples[Sample] = 1;
+		}
+
+		RangeCounts.Add(RangeHeights.Num() - NumBefore);
+	}
+
+	// splice the new surfaces in place of the old ones and shift the offsets after them
+	const int32 OldBegin = SampleOffsets[FirstSample];
+	const int32 OldEnd = SampleOffsets[LastSample + 1];
+
+	SurfaceHeights.RemoveAt(OldBegin, OldEnd - OldBegin, EAllowShrinking::No);
+	SurfaceHeights.Insert(RangeHeights, OldBegin);
+
+	for (int32 Sample = FirstSample; Sample <= LastSample; ++Sample)
+	{
+		SampleOffsets[Sample + 1] = SampleOffsets[Sample] + RangeCounts[Sample - FirstSample];
+	}
+
+	const int32 Shift = RangeHeights.Num() - (OldEnd - OldBegin);
+
+	for (int32 Index = LastSample + 2; Index < SampleOffsets.Num(); ++Index)
+	{
+		SampleOffsets[Index] += Shift;
+	}
+}
+
+void ASideScrollingGroundProfile::FlagPlatformSamples(const int32 FirstSample, const int32 LastSample, FCollisionQueryParams& OutQueryParams)
+{
+	// moving platforms are not static ground. Ignore them and flag every sample they can pass over instead
+	OutQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SideScrollingGroundProfile), false, this);
+
+	for (TActorIterator<ASideScrollingMovingPlatform> It(GetWorld()); It; ++It)
+	{
+		ASideScrollingMovingPlatform* Platform = *It;
+		OutQueryParams.AddIgnoredActor(Platform);
+
+		FVector Origin, Extent;
+		Platform->GetActorBounds(true, Origin, Extent);
+
+		// cover both the current position and the destination
+		const float MinX = FMath::Min(Origin.X, Platform->GetPlatformTarget().X) - Extent.X;
+		const float MaxX = FMath::Max(Origin.X, Platform->GetPlatformTarget().X) + Extent.X;
+
+		const int32 PlatformFirstSample = FMath::Max(FirstSample, FMath::FloorToInt32((MinX - ProfileMinX) / ProfileSpacing));
+		const int32 PlatformLastSample = FMath::Min(LastSample, FMath::CeilToInt32((MaxX - ProfileMinX) / ProfileSpacing));
+
+		for (int32 Sample = PlatformFirstSample; Sample <= PlatformLastSample; ++Sample)
+		{
+			FallbackSamples[Sample] = 1;
+		}
+	}
+}
+
+bool ASideScrollingGroundProfile::TraceSample(const int32 Sample, const FCollisionQueryParams& QueryParams, TArray<float>& OutHeights) const
+{
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+
+	// how far below a hit the next trace starts, so it leaves the surface it hit without skipping the ones under it
+	constexpr float SurfaceSkipDistance = 1.0f;
+
+	const float X = ProfileMinX + Sample * ProfileSpacing;
+
+	FVector Start(X, BakePlaneY, BakeTopZ);
+	const FVector End(X, BakePlaneY, BakeBottomZ);
+
+	// walk down through the stacked surfaces, restarting each trace just under the last hit.
+	// components aren't ignored, since instanced meshes, landscapes and merged meshes can have several surfaces stacked at one X
+	int32 NumSurfaces = 0;
+
+	FHitResult OutHit;
+
+	while (Start.Z > End.Z && GetWorld()->LineTraceSingleByObjectType(OutHit, Start, End, ObjectParams, QueryParams))
+	{
+		// restarting under a surface usually puts us inside the solid it belongs to. That's not a surface,
+		// so step down through the solid until we're out of it
+		if (OutHit.bStartPenetrating)
+		{
+			Start.Z -= SolidStepDistance;
+			continue;
+		}
+
+		if (OutHit.ImpactNormal.Z >= WalkableNormalZ)
+		{
+			// we ran out of room for this sample, so it can't rule out the ground below
+			if (NumSurfaces == MaxSurfacesPerSample)
+			{
+				return false;
+			}
+
+			OutHeights.Add(OutHit.ImpactPoint.Z);
+			++NumSurfaces;
+		}
+
+		// always make progress, even if the hit reported a point at or above the start
+		Start.Z = FMath::Min(OutHit.ImpactPoint.Z, Start.Z) - SurfaceSkipDistance;
+	}
+
+	return true;
+}
+
+ESideScrollingGroundLookup ASideScrollingGroundProfile::FindGroundBelow(const FVector& Location, float MaxDistance) const
+{
+	if (!HasProfile() || ProfileSpacing <= 0.0f)
+	{
+		return ESideScrollingGroundLookup::Unknown;
+	}
+
+	// find the nearest sample
+	const int32 Sample = FMath::RoundToInt32((Location.X - ProfileMinX) / ProfileSpacing);
+
+	if (Sample < 0 || Sample >= SampleOffsets.Num() - 1)
+	{
+		return ESideScrollingGroundLookup::Unknown;
+	}
+
+	// surfaces are sorted highest first, so the first one below us is the closest
+	for (int32 Index = SampleOffsets[Sample]; Index < SampleOffsets[Sample + 1]; ++Index)
+	{
+		const float Height = SurfaceHeights[Index];
+
+		if (Height <= Location.Z)
+		{
+			if (Location.Z - Height <= MaxDistance)
+			{
+				return ESideScrollingGroundLookup::Ground;
+			}
+
+			break;
+		}
+	}
+
+	return FallbackSamples[Sample] ? ESideScrollingGroundLookup::Unknown : ESideScrollingGroundLookup::NoGround;
+}
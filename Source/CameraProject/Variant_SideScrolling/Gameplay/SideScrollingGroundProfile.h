@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SideScrollingGroundProfile.generated.h"
+
+struct FCollisionQueryParams;
+
+/** Result of a ground profile lookup */
+enum class ESideScrollingGroundLookup : uint8
+{
+	/** Static ground was found within range below the location */
+	Ground,
+
+	/** No static ground within range, and no dynamic platform can be there */
+	NoGround,
+
+	/** The profile can't answer: the location is outside the baked range or over a dynamic platform */
+	Unknown
+};
+
+/**
+ *  Baked height profile of the walkable static ground along the X axis of a side scrolling level.
+ *  Each sample stores the surfaces found by tracing straight down at that X, so ground checks become a constant time lookup.
+ *  Samples that moving platforms can pass over are flagged so callers know to fall back to a trace.
+ *  Place one in the level and bake it in the editor; it is saved with the map.
+ *  Level chunks streamed in at runtime are re-traced by the level streamer once they're visible.
+ */
+UCLASS()
+class ASideScrollingGroundProfile : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ASideScrollingGroundProfile();
+
+protected:
+
+	/** Start of the baked range along X, in world space */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float BakeMinX = -1000.0f;
+
+	/** End of the baked range along X, in world space */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float BakeMaxX = 11000.0f;
+
+	/** Distance between samples along X */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=5, ClampMax=500, Units="cm"))
+	float SampleSpacing = 25.0f;
+
+	/** Y coordinate of the plane the bake traces run in. Should match the plane the side scrolling characters are constrained to */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float BakePlaneY = 0.0f;
+
+	/** Height the bake traces start from */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float BakeTopZ = 5000.0f;
+
+	/** Height the bake traces end at */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
+	float BakeBottomZ = -5000.0f;
+
+	/** Maximum number of stacked surfaces recorded per sample */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=1, ClampMax=8))
+	int32 MaxSurfacesPerSample = 4;
+
+	/** Distance the bake steps down through solid geometry. Surfaces closer than this under a solid have no room to stand on and are skipped */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=1, ClampMax=1000, Units="cm"))
+	float SolidStepDistance = 50.0f;
+
+	/** Minimum surface normal Z for a surface to count as walkable ground */
+	UPROPERTY(EditAnywhere, Category="Ground Profile", meta=(ClampMin=0, ClampMax=1))
+	float WalkableNormalZ = 0.7f;
+
+	/** If true and no profile has been baked, the profile is baked on BeginPlay. Off by default, since the bake should happen in the editor */
+	UPROPERTY(EditAnywhere, Category="Ground Profile")
+	bool bBakeOnBeginPlay = false;
+
+	/** X coordinate of the first baked sample */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile|Baked")
+	float ProfileMinX = 0.0f;
+
+	/** Spacing the profile was baked with */
+	UPROPERTY(VisibleAnywhere, Category="Ground Profile|Baked")
+	float ProfileSpacing = 0.0f;
+
+	/** Index of the first surface of each sample in SurfaceHeights. Has one extra entry past the last sample */
+	UPROPERTY()
+	TArray<int32> SampleOffsets;
+
+	/** Heights of the walkable surfaces of all samples, highest first within each sample */
+	UPROPERTY()
+	TArray<float> SurfaceHeights;
+
+	/** Per sample flag, set where the profile can't rule out ground: moving platforms pass by, or there were more surfaces than recorded */
+	UPROPERTY()
+	TArray<uint8> FallbackSamples;
+
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Flags the samples in the range that moving platforms can pass over, and sets up the bake trace params to ignore the platforms */
+	void FlagPlatformSamples(int32 FirstSample, int32 LastSample, FCollisionQueryParams& OutQueryParams);
+
+	/** Traces one sample and appends its walkable surfaces, highest first. Returns false if there were more than MaxSurfacesPerSample */
+	bool TraceSample(int32 Sample, const FCollisionQueryParams& QueryParams, TArray<float>& OutHeights) const;
+
+public:
+
+	/** Traces the level along the baked range and rebuilds the profile */
+	UFUNCTION(CallInEditor, Category="Ground Profile")
+	void BakeProfile();
+
+	/** Re-traces the baked samples covering the X range, e.g. after level geometry streamed in there */
+	void RebakeRange(float MinX, float MaxX);
+
+	/** Returns true if the profile has baked data */
+	bool HasProfile() const { return SampleOffsets.Num() > 1; }
+
+	/** Looks up whether there is static ground between the location and MaxDistance below it */
+	ESideScrollingGroundLookup FindGroundBelow(const FVector& Location, float MaxDistance) const;
+};
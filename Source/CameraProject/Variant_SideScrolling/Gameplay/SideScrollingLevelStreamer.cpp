@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingLevelStreamer.h"
+#include "SideScrollingGroundProfile.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "CameraProject.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Side Scrolling Loaded Chunks"), STAT_SideScrollingLoadedChunks, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Side Scrolling Pending Chunks"), STAT_SideScrollingPendingChunks, STATGROUP_CameraProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Side Scrolling Chunk Stream-In (ms)"), STAT_SideScrollingChunkLatency, STATGROUP_CameraProject);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Side Scrolling Memory High Water (MB)"), STAT_SideScrollingMemoryHighWater, STATGROUP_CameraProject);
+
+ASideScrollingLevelStreamer::ASideScrollingLevelStreamer()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the root comp
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASideScrollingLevelStreamer::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// keep the chunks in X order
+	Chunks.Sort([](const FSideScrollingLevelChunk& A, const FSideScrollingLevelChunk& B) { return A.MinX < B.MinX; });
+
+	ChunkStates.SetNum(Chunks.Num());
+
+	// find where the player spawns
+	float StartX = GetActorLocation().X;
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		StartX = It->GetActorLocation().X;
+		break;
+	}
+
+	// find the ground profile, so it can pick up the chunks' geometry once they're in
+	for (TActorIterator<ASideScrollingGroundProfile> It(GetWorld()); It; ++It)
+	{
+		GroundProfile = *It;
+		break;
+	}
+
+	// block on the chunks around the start, so the player doesn't spawn over a level that hasn't streamed in yet
+	bool bAnyLoaded = false;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const FSideScrollingLevelChunk& Chunk = Chunks[ChunkIndex];
+
+		if (Chunk.MaxX >= StartX - LoadBehindDistance && Chunk.MinX <= StartX + LoadAheadDistance)
+		{
+			LoadChunk(ChunkIndex, true);
+			bAnyLoaded = true;
+		}
+	}
+
+	if (bAnyLoaded)
+	{
+		GetWorld()->FlushLevelStreaming();
+	}
+}
+
+void ASideScrollingLevelStreamer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (int32 ChunkIndex = 0; ChunkIndex < ChunkStates.Num(); ++ChunkIndex)
+	{
+		UnloadChunk(ChunkIndex);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASideScrollingLevelStreamer::UpdateStreaming(const float CameraX, const float VelocityX)
+{
+	// keep the last direction while standing still, so we don't drop what we just prefetched
+	if (!FMath::IsNearlyZero(VelocityX, 1.0f))
+	{
+		LastScrollDirection = FMath::Sign(VelocityX);
+	}
+
+	// extend the range ahead of the scroll direction by how far we'll travel soon
+	const float Ahead = LoadAheadDistance + FMath::Abs(VelocityX) * VelocityLookAhead;
+	const float Behind = LoadBehindDistance;
+
+	const float LoadMinX = CameraX - (LastScrollDirection > 0.0f ? Behind : Ahead);
+	const float LoadMaxX = CameraX + (LastScrollDirection > 0.0f ? Ahead : Behind);
+
+	int32 NumLoaded = 0;
+	int32 NumPending = 0;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const FSideScrollingLevelChunk& Chunk = Chunks[ChunkIndex];
+		FChunkState& State = ChunkStates[ChunkIndex];
+
+		// the streaming level went away without us, so forget it and request it again if we still need it
+		if (!State.Streaming.IsValid())
+		{
+			State = FChunkState();
+		}
+
+		const bool bLoaded = State.Streaming.IsValid();
+
+		if (!bLoaded)
+		{
+			// load chunks overlapping the load range
+			if (Chunk.MaxX >= LoadMinX && Chunk.MinX <= LoadMaxX)
+			{
+				LoadChunk(ChunkIndex);
+			}
+
+		} else if (Chunk.MaxX < LoadMinX - UnloadHysteresis || Chunk.MinX > LoadMaxX + UnloadHysteresis) {
+
+			// unload chunks well outside of it
+			UnloadChunk(ChunkIndex);
+			continue;
+		}
+
+		// report chunks that just finished streaming in
+		if (State.bPending && State.Streaming->IsLevelVisible())
+		{
+			State.bPending = false;
+
+			const float LatencyMs = static_cast<float>((FPlatformTime::Seconds() - State.RequestTime) * 1000.0);
+			SET_FLOAT_STAT(STAT_SideScrollingChunkLatency, LatencyMs);
+
+			MemoryHighWaterMark = FMath::Max<uint64>(MemoryHighWaterMark, FPlatformMemory::GetStats().PeakUsedPhysical);
+			SET_FLOAT_STAT(STAT_SideScrollingMemoryHighWater, static_cast<float>(MemoryHighWaterMark / (1024.0 * 1024.0)));
+
+			UE_LOG(LogCameraProject, Log, TEXT("Streamed in chunk %d (%s) in %.1f ms. Memory high water mark: %.1f MB"),
+				ChunkIndex, *Chunk.Level.GetAssetName(), LatencyMs, MemoryHighWaterMark / (1024.0 * 1024.0));
+
+			// the profile was baked without this chunk, so trace its ground now
+			if (ASideScrollingGroundProfile* Profile = GroundProfile.Get())
+			{
+				Profile->RebakeRange(Chunk.MinX, Chunk.MaxX);
+			}
+		}
+
+		if (State.Streaming.IsValid())
+		{
+			++NumLoaded;
+		}
+
+		if (State.bPending)
+		{
+			++NumPending;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SideScrollingLoadedChunks, NumLoaded);
+	SET_DWORD_STAT(STAT_SideScrollingPendingChunks, NumPending);
+}
+
+void ASideScrollingLevelStreamer::LoadChunk(const int32 ChunkIndex, const bool bBlockOnLoad)
+{
+	const FSideScrollingLevelChunk& Chunk = Chunks[ChunkIndex];
+	FChunkState& State = ChunkStates[ChunkIndex];
+
+	if (Chunk.Level.IsNull())
+	{
+		return;
+	}
+
+	// level instances stream asynchronously unless told to block
+	bool bSuccess = false;
+	ULevelStreamingDynamic* Streaming = ULevelStreamingDynamic::LoadLevelInstanceBySoftObjectPtr(this, Chunk.Level, Chunk.Offset, FRotator::ZeroRotator, bSuccess);
+
+	if (!bSuccess || !Streaming)
+	{
+		UE_LOG(LogCameraProject, Warning, TEXT("Failed to stream in chunk %d (%s)."), ChunkIndex, *Chunk.Level.ToString());
+		return;
+	}
+
+	Streaming->bShouldBlockOnLoad = bBlockOnLoad;
+
+	State.Streaming = Streaming;
+	State.RequestTime = FPlatformTime::Seconds();
+	State.bPending = true;
+}
+
+void ASideScrollingLevelStreamer::UnloadChunk(const int32 ChunkIndex)
+{
+	FChunkState& State = ChunkStates[ChunkIndex];
+
+	if (ULevelStreamingDynamic* Streaming = State.Streaming.Get())
+	{
+		Streaming->SetIsRequestingUnloadAndRemoval(true);
+	}
+
+	State = FChunkState();
+}
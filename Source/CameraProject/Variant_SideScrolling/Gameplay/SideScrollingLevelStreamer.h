@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SideScrollingLevelStreamer.generated.h"
+
+class UWorld;
+class ULevelStreamingDynamic;
+class ASideScrollingGroundProfile;
+
+/**
+ *  A section of a long side scrolling level, streamed in as a level instance
+ */
+USTRUCT(BlueprintType)
+struct FSideScrollingLevelChunk
+{
+	GENERATED_BODY()
+
+	/** Level to instance for this chunk */
+	UPROPERTY(EditAnywhere, Category="Chunk")
+	TSoftObjectPtr<UWorld> Level;
+
+	/** World space offset the level is instanced at */
+	UPROPERTY(EditAnywhere, Category="Chunk")
+	FVector Offset = FVector::ZeroVector;
+
+	/** Start of the X range covered by this chunk, in world space */
+	UPROPERTY(EditAnywhere, Category="Chunk", meta=(Units="cm"))
+	float MinX = 0.0f;
+
+	/** End of the X range covered by this chunk, in world space */
+	UPROPERTY(EditAnywhere, Category="Chunk", meta=(Units="cm"))
+	float MaxX = 0.0f;
+};
+
+/**
+ *  Streams the chunks of a long side scrolling level around the camera.
+ *  Chunks are loaded asynchronously ahead of the scroll direction, further ahead the faster the view target moves,
+ *  and unloaded once they're far enough behind. Driven by the side scrolling camera manager.
+ *  The level's ground profile is re-traced over each chunk once it's visible.
+ */
+UCLASS()
+class ASideScrollingLevelStreamer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ASideScrollingLevelStreamer();
+
+protected:
+
+	/** Chunks that make up the level */
+	UPROPERTY(EditAnywhere, Category="Level Streaming")
+	TArray<FSideScrollingLevelChunk> Chunks;
+
+	/** Distance ahead of the camera, in the scroll direction, where chunks are loaded */
+	UPROPERTY(EditAnywhere, Category="Level Streaming", meta=(ClampMin=0, ClampMax=100000, Units="cm"))
+	float LoadAheadDistance = 4000.0f;
+
+	/** Distance behind the camera where chunks are kept loaded */
+	UPROPERTY(EditAnywhere, Category="Level Streaming", meta=(ClampMin=0, ClampMax=100000, Units="cm"))
+	float LoadBehindDistance = 2000.0f;
+
+	/** Extra distance past the load range before a chunk is unloaded, so chunks don't thrash at the edges */
+	UPROPERTY(EditAnywhere, Category="Level Streaming", meta=(ClampMin=0, ClampMax=100000, Units="cm"))
+	float UnloadHysteresis = 1500.0f;
+
+	/** Seconds of view target velocity added to the load ahead distance */
+	UPROPERTY(EditAnywhere, Category="Level Streaming", meta=(ClampMin=0, ClampMax=10, Units="s"))
+	float VelocityLookAhead = 1.5f;
+
+	/** Streaming state of a chunk */
+	struct FChunkState
+	{
+		TWeakObjectPtr<ULevelStreamingDynamic> Streaming;
+		double RequestTime = 0.0;
+
+		/** Requested but not visible yet */
+		bool bPending = false;
+	};
+
+	/** Streaming state for each chunk, parallel to Chunks */
+	TArray<FChunkState> ChunkStates;
+
+	/** Ground profile of the level, re-traced over chunks as they stream in */
+	TWeakObjectPtr<ASideScrollingGroundProfile> GroundProfile;
+
+	/** Peak physical memory use seen after a chunk finished streaming in */
+	uint64 MemoryHighWaterMark = 0;
+
+	/** Scroll direction from the last update. Kept while the view target stands still */
+	float LastScrollDirection = 1.0f;
+
+protected:
+
+	/** Gameplay initialization. Blocks on loading the chunks around the player start */
+	virtual void BeginPlay() override;
+
+	/** Unloads every chunk */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Starts streaming in a chunk. Blocking loads complete on the next level streaming flush */
+	void LoadChunk(int32 ChunkIndex, bool bBlockOnLoad = false);
+
+	/** Unloads a chunk */
+	void UnloadChunk(int32 ChunkIndex);
+
+public:
+
+	/** Loads and unloads chunks around the camera. Called by the camera manager every frame */
+	void UpdateStreaming(float CameraX, float VelocityX);
+
+	/** Returns the peak physical memory use seen after a chunk finished streaming in, in bytes */
+	uint64 GetMemoryHighWaterMark() const { return MemoryHighWaterMark; }
+};
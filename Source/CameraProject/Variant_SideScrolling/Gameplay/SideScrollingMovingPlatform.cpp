@@ -3,6 +3,8 @@
 
 #include "SideScrollingMovingPlatform.h"
 #include "Components/SceneComponent.h"
+#include "SideScrollingActivationSubsystem.h"
+#include "Engine/World.h"
 
 ASideScrollingMovingPlatform::ASideScrollingMovingPlatform()
 {
@@ -38,3 +40,24 @@ void ASideScrollingMovingPlatform::ResetInteraction()
 	// reset the movement flag
 	bMoving = false;
 }
+
+void ASideScrollingMovingPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// sleep while we're outside of the camera window
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->RegisterActor(this);
+	}
+}
+
+void ASideScrollingMovingPlatform::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
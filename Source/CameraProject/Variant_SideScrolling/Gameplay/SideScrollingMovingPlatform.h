@@ -38,6 +38,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Moving Platform")
 	bool bOneShot = false;
 
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 public:
 
 // ~begin IInteractable interface 
@@ -47,6 +55,9 @@ public:
 
 // ~end IInteractable interface
 
+	/** Returns the destination of the platform in world space */
+	const FVector& GetPlatformTarget() const { return PlatformTarget; }
+
 	/** Resets the interaction state. Must be called from BP code to reset the platform */
 	UFUNCTION(BlueprintCallable, Category="Moving Platform")
 	virtual void ResetInteraction();
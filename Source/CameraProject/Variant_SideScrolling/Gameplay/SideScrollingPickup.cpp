@@ -7,6 +7,7 @@
 #include "Components/SphereComponent.h"
 #include "Components/SceneComponent.h"
 #include "Engine/World.h"
+#include "SideScrollingActivationSubsystem.h"
 
 ASideScrollingPickup::ASideScrollingPickup()
 {
@@ -52,4 +53,25 @@ void ASideScrollingPickup::BeginOverlap(AActor* OverlappedActor, AActor* OtherAc
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+void ASideScrollingPickup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// sleep while we're outside of the camera window
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->RegisterActor(this);
+	}
+}
+
+void ASideScrollingPickup::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+	{
+		Activation->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -26,6 +26,14 @@ public:
 	/** Constructor */
 	ASideScrollingPickup();
 
+protected:
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
+	/** Cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 protected:
 
 	/** Handles pickup collision */
@@ -0,0 +1,277 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingActivationSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "Components/ActorComponent.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "CameraProject.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Side Scrolling Active Actors"), STAT_SideScrollingActiveActors, STATGROUP_CameraProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Side Scrolling Dormant Actors"), STAT_SideScrollingDormantActors, STATGROUP_CameraProject);
+
+/** Width of an activation bucket along X */
+static constexpr double ActivationBucketSize = 1000.0;
+
+void USideScrollingActivationSubsystem::RegisterActor(AActor* Actor)
+{
+	if (!Actor || ActorToEntry.Contains(Actor))
+	{
+		return;
+	}
+
+	FActivationEntry NewEntry;
+	NewEntry.Actor = Actor;
+	NewEntry.Bucket = GetBucket(Actor->GetActorLocation().X);
+
+	const int32 EntryIndex = Entries.Add(MoveTemp(NewEntry));
+	ActorToEntry.Add(Actor, EntryIndex);
+	Buckets.FindOrAdd(Entries[EntryIndex].Bucket).Add(EntryIndex);
+
+	// new actors start active. The next window update puts them to sleep if the camera is elsewhere,
+	// which also gives AI controllers a chance to start their logic first
+	ActiveEntries.Add(EntryIndex);
+}
+
+void USideScrollingActivationSubsystem::UnregisterActor(AActor* Actor)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!ActorToEntry.RemoveAndCopyValue(Actor, EntryIndex))
+	{
+		return;
+	}
+
+	// give back anything we suspended
+	if (Entries[EntryIndex].bDormant)
+	{
+		MakeActive(EntryIndex);
+	}
+
+	ActiveEntries.RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+
+	if (TArray<int32>* Bucket = Buckets.Find(Entries[EntryIndex].Bucket))
+	{
+		Bucket->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	}
+
+	Entries.RemoveAt(EntryIndex);
+}
+
+void USideScrollingActivationSubsystem::UpdateWindow(const float MinX, const float MaxX)
+{
+	// active actors may have moved, so keep their buckets current
+	for (const int32 EntryIndex : ActiveEntries)
+	{
+		if (const AActor* Actor = Entries[EntryIndex].Actor.Get())
+		{
+			const int32 NewBucket = GetBucket(Actor->GetActorLocation().X);
+
+			if (NewBucket != Entries[EntryIndex].Bucket)
+			{
+				SetEntryBucket(EntryIndex, NewBucket);
+			}
+		}
+	}
+
+	const int32 NewMinBucket = GetBucket(MinX);
+	const int32 NewMaxBucket = GetBucket(MaxX);
+
+	if (!bHasWindow)
+	{
+		// first window: put everything outside of it to sleep
+		bHasWindow = true;
+		WindowMinBucket = NewMinBucket;
+		WindowMaxBucket = NewMaxBucket;
+
+		for (const TPair<int32, TArray<int32>>& Bucket : Buckets)
+		{
+			if (!IsBucketInWindow(Bucket.Key))
+			{
+				SetBucketActive(Bucket.Key, false);
+			}
+		}
+
+	} else if (NewMinBucket != WindowMinBucket || NewMaxBucket != WindowMaxBucket) {
+
+		const int32 OldMinBucket = WindowMinBucket;
+		const int32 OldMaxBucket = WindowMaxBucket;
+
+		WindowMinBucket = NewMinBucket;
+		WindowMaxBucket = NewMaxBucket;
+
+		// only touch the buckets that left or entered the window
+		for (int32 Bucket = OldMinBucket; Bucket <= OldMaxBucket; ++Bucket)
+		{
+			if (!IsBucketInWindow(Bucket))
+			{
+				SetBucketActive(Bucket, false);
+			}
+		}
+
+		for (int32 Bucket = NewMinBucket; Bucket <= NewMaxBucket; ++Bucket)
+		{
+			if (Bucket < OldMinBucket || Bucket > OldMaxBucket)
+			{
+				SetBucketActive(Bucket, true);
+			}
+		}
+	}
+
+	// put to sleep any active actor that walked out of the window on its own
+	for (int32 Index = ActiveEntries.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 EntryIndex = ActiveEntries[Index];
+
+		if (!IsBucketInWindow(Entries[EntryIndex].Bucket))
+		{
+			MakeDormant(EntryIndex);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SideScrollingActiveActors, GetNumActive());
+	SET_DWORD_STAT(STAT_SideScrollingDormantActors, GetNumDormant());
+}
+
+int32 USideScrollingActivationSubsystem::GetBucket(const double X)
+{
+	return FMath::FloorToInt32(X / ActivationBucketSize);
+}
+
+bool USideScrollingActivationSubsystem::IsBucketInWindow(const int32 Bucket) const
+{
+	return !bHasWindow || (Bucket >= WindowMinBucket && Bucket <= WindowMaxBucket);
+}
+
+void USideScrollingActivationSubsystem::SetEntryBucket(const int32 EntryIndex, const int32 NewBucket)
+{
+	FActivationEntry& Entry = Entries[EntryIndex];
+
+	if (TArray<int32>* OldBucket = Buckets.Find(Entry.Bucket))
+	{
+		OldBucket->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	}
+
+	Entry.Bucket = NewBucket;
+	Buckets.FindOrAdd(NewBucket).Add(EntryIndex);
+}
+
+void USideScrollingActivationSubsystem::MakeDormant(const int32 EntryIndex)
+{
+	FActivationEntry& Entry = Entries[EntryIndex];
+
+	if (Entry.bDormant)
+	{
+		return;
+	}
+
+	Entry.bDormant = true;
+	ActiveEntries.RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+
+	AActor* Actor = Entry.Actor.Get();
+
+	if (!Actor)
+	{
+		return;
+	}
+
+	// save and disable the actor tick and collision
+	Entry.bTickWasEnabled = Actor->IsActorTickEnabled();
+	Actor->SetActorTickEnabled(false);
+
+	Entry.bCollisionWasEnabled = Actor->GetActorEnableCollision();
+	Actor->SetActorEnableCollision(false);
+
+	// stop ticking components. This covers movement and animation
+	Entry.SuspendedComponents.Reset();
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && Component->IsComponentTickEnabled())
+		{
+			Component->SetComponentTickEnabled(false);
+			Entry.SuspendedComponents.Add(Component);
+		}
+	}
+
+	// pause the AI logic, if any
+	if (const APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (const AAIController* AIController = Cast<AAIController>(Pawn->GetController()))
+		{
+			if (UBrainComponent* Brain = AIController->GetBrainComponent())
+			{
+				Brain->PauseLogic(TEXT("Outside of the camera window"));
+			}
+		}
+	}
+}
+
+void USideScrollingActivationSubsystem::MakeActive(const int32 EntryIndex)
+{
+	FActivationEntry& Entry = Entries[EntryIndex];
+
+	if (!Entry.bDormant)
+	{
+		return;
+	}
+
+	Entry.bDormant = false;
+	ActiveEntries.Add(EntryIndex);
+
+	AActor* Actor = Entry.Actor.Get();
+
+	if (!Actor)
+	{
+		return;
+	}
+
+	// restore the actor the way we found it
+	Actor->SetActorTickEnabled(Entry.bTickWasEnabled);
+	Actor->SetActorEnableCollision(Entry.bCollisionWasEnabled);
+
+	for (const TWeakObjectPtr<UActorComponent>& Component : Entry.SuspendedComponents)
+	{
+		if (Component.IsValid())
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+
+	Entry.SuspendedComponents.Reset();
+
+	// resume the AI logic
+	if (const APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (const AAIController* AIController = Cast<AAIController>(Pawn->GetController()))
+		{
+			if (UBrainComponent* Brain = AIController->GetBrainComponent())
+			{
+				Brain->ResumeLogic(TEXT("Inside of the camera window"));
+			}
+		}
+	}
+}
+
+void USideScrollingActivationSubsystem::SetBucketActive(const int32 Bucket, const bool bActive)
+{
+	const TArray<int32>* BucketEntries = Buckets.Find(Bucket);
+
+	if (!BucketEntries)
+	{
+		return;
+	}
+
+	for (const int32 EntryIndex : *BucketEntries)
+	{
+		if (bActive)
+		{
+			MakeActive(EntryIndex);
+
+		} else {
+
+			MakeDormant(EntryIndex);
+		}
+	}
+}
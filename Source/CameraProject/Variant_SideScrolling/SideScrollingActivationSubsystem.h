@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/SparseArray.h"
+#include "SideScrollingActivationSubsystem.generated.h"
+
+class UActorComponent;
+
+/**
+ *  World subsystem that keeps side scrolling actors dormant while they're outside the camera window.
+ *  Registered actors are bucketed by X. As the camera manager slides the window, only the buckets entering or leaving it are touched.
+ *  Dormant actors have their ticks, collision and AI logic suspended, and restored as they were when they come back into the window.
+ */
+UCLASS()
+class USideScrollingActivationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds an actor to the activation buckets. It goes dormant on the next window update if it's outside the window */
+	void RegisterActor(AActor* Actor);
+
+	/** Removes an actor from the activation buckets, reactivating it if it was dormant */
+	void UnregisterActor(AActor* Actor);
+
+	/** Moves the activation window. Called by the camera manager every frame */
+	void UpdateWindow(float MinX, float MaxX);
+
+	/** Returns the number of registered actors currently active */
+	int32 GetNumActive() const { return ActiveEntries.Num(); }
+
+	/** Returns the number of registered actors currently dormant */
+	int32 GetNumDormant() const { return Entries.Num() - ActiveEntries.Num(); }
+
+protected:
+
+	/** Registered actor and what was suspended while it was dormant */
+	struct FActivationEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 Bucket = 0;
+		bool bDormant = false;
+		bool bTickWasEnabled = false;
+		bool bCollisionWasEnabled = false;
+		TArray<TWeakObjectPtr<UActorComponent>> SuspendedComponents;
+	};
+
+	/** Returns the bucket an X coordinate falls in */
+	static int32 GetBucket(double X);
+
+	/** Returns true if the bucket is inside the current window */
+	bool IsBucketInWindow(int32 Bucket) const;
+
+	/** Moves an entry to a new bucket */
+	void SetEntryBucket(int32 EntryIndex, int32 NewBucket);
+
+	/** Suspends ticks, collision and AI logic on an entry's actor */
+	void MakeDormant(int32 EntryIndex);
+
+	/** Restores what MakeDormant suspended */
+	void MakeActive(int32 EntryIndex);
+
+	/** Activates or deactivates every entry in a bucket */
+	void SetBucketActive(int32 Bucket, bool bActive);
+
+	/** Registered entries. Sparse so indices stay stable */
+	TSparseArray<FActivationEntry> Entries;
+
+	/** Entry indices in each X bucket */
+	TMap<int32, TArray<int32>> Buckets;
+
+	/** Actor to entry index lookup */
+	TMap<TWeakObjectPtr<AActor>, int32> ActorToEntry;
+
+	/** Indices of the entries that are currently active. Active actors may move, so they're re-bucketed every update */
+	TArray<int32> ActiveEntries;
+
+	/** First bucket in the activation window */
+	int32 WindowMinBucket = 0;
+
+	/** Last bucket in the activation window */
+	int32 WindowMaxBucket = 0;
+
+	/** Set once the camera has reported a window. Until then, everything stays active */
+	bool bHasWindow = false;
+};
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingCameraBoundsSubsystem.h"
+#include "SideScrollingCameraBounds.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
+void USideScrollingCameraBoundsSubsystem::RegisterBounds(ASideScrollingCameraBounds* Bounds)
+{
+	if (!Bounds)
+	{
+		return;
+	}
+
+	FBoundsEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Bounds = Bounds;
+	Entry.XRange = Bounds->GetXRange();
+	Entry.Priority = Bounds->GetPriority();
+
+	bIndexDirty = true;
+}
+
+void USideScrollingCameraBoundsSubsystem::UnregisterBounds(ASideScrollingCameraBounds* Bounds)
+{
+	if (Entries.RemoveAll([Bounds](const FBoundsEntry& Entry) { return Entry.Bounds.Get() == Bounds; }) > 0)
+	{
+		bIndexDirty = true;
+	}
+}
+
+const ASideScrollingCameraBounds* USideScrollingCameraBoundsSubsystem::FindBounds(const float X)
+{
+	if (bIndexDirty)
+	{
+		RebuildIndex();
+	}
+
+	// check the last segment first, then binary search for the new one
+	if (!SegmentEntries.IsValidIndex(LastSegment) || X < Breakpoints[LastSegment] || X >= Breakpoints[LastSegment + 1])
+	{
+		LastSegment = Algo::UpperBound(Breakpoints, X) - 1;
+	}
+
+	if (!SegmentEntries.IsValidIndex(LastSegment) || SegmentEntries[LastSegment] == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return Entries[SegmentEntries[LastSegment]].Bounds.Get();
+}
+
+void USideScrollingCameraBoundsSubsystem::RebuildIndex()
+{
+	bIndexDirty = false;
+	LastSegment = INDEX_NONE;
+
+	Breakpoints.Reset(Entries.Num() * 2);
+	SegmentEntries.Reset();
+
+	// every volume edge is a place where the active volume may change
+	for (const FBoundsEntry& Entry : Entries)
+	{
+		Breakpoints.Add(Entry.XRange.Min);
+		Breakpoints.Add(Entry.XRange.Max);
+	}
+
+	Breakpoints.Sort();
+	Breakpoints.SetNum(Algo::Unique(Breakpoints));
+
+	if (Breakpoints.Num() < 2)
+	{
+		Breakpoints.Reset();
+		return;
+	}
+
+	// resolve each segment to the highest priority volume covering it
+	SegmentEntries.Init(INDEX_NONE, Breakpoints.Num() - 1);
+
+	for (int32 Segment = 0; Segment < SegmentEntries.Num(); ++Segment)
+	{
+		const float Midpoint = 0.5f * (Breakpoints[Segment] + Breakpoints[Segment + 1]);
+
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			const FBoundsEntry& Entry = Entries[EntryIndex];
+
+			if (!Entry.XRange.Contains(Midpoint))
+			{
+				continue;
+			}
+
+			int32& Best = SegmentEntries[Segment];
+
+			if (Best == INDEX_NONE || Entry.Priority > Entries[Best].Priority)
+			{
+				Best = EntryIndex;
+			}
+		}
+	}
+}
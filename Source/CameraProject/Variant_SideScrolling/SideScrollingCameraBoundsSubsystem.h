@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SideScrollingCameraBoundsSubsystem.generated.h"
+
+class ASideScrollingCameraBounds;
+
+/**
+ *  World subsystem that indexes the camera bounds volumes of a side scrolling level along X.
+ *  The volume ranges are flattened into sorted breakpoints, each segment already resolved to its highest priority volume,
+ *  so finding the active volume is a binary search regardless of how many sections the level has.
+ */
+UCLASS()
+class USideScrollingCameraBoundsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds a volume to the index */
+	void RegisterBounds(ASideScrollingCameraBounds* Bounds);
+
+	/** Removes a volume from the index */
+	void UnregisterBounds(ASideScrollingCameraBounds* Bounds);
+
+	/** Returns the highest priority volume covering the X coordinate, or nullptr if there's none */
+	const ASideScrollingCameraBounds* FindBounds(float X);
+
+protected:
+
+	/** Rebuilds the breakpoint index from the registered volumes */
+	void RebuildIndex();
+
+	/** Registered volume with its cached range */
+	struct FBoundsEntry
+	{
+		TWeakObjectPtr<ASideScrollingCameraBounds> Bounds;
+		FFloatInterval XRange;
+		int32 Priority = 0;
+	};
+
+	/** Registered volumes */
+	TArray<FBoundsEntry> Entries;
+
+	/** Sorted X coordinates where the active volume may change */
+	TArray<float> Breakpoints;
+
+	/** Entry index active between each pair of breakpoints, or INDEX_NONE */
+	TArray<int32> SegmentEntries;
+
+	/** Segment returned by the last query. Checked first since the view target rarely leaves it */
+	int32 LastSegment = INDEX_NONE;
+
+	/** Set when volumes were added or removed since the last rebuild */
+	bool bIndexDirty = false;
+};
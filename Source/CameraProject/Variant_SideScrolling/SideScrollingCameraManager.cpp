@@ -6,6 +6,12 @@
 #include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "SideScrollingGroundProfile.h"
+#include "SideScrollingCameraBounds.h"
+#include "SideScrollingCameraBoundsSubsystem.h"
+#include "SideScrollingActivationSubsystem.h"
+#include "SideScrollingLevelStreamer.h"
 
 void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
@@ -25,8 +31,20 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 		// copy the current camera location
 		FVector CurrentCameraLocation = GetCameraLocation();
 
+		// find the camera bounds volume for the section of the level we're in.
+		// we keep the last section until the target enters a different one, so gaps between volumes don't release the camera
+		if (USideScrollingCameraBoundsSubsystem* BoundsSubsystem = GetWorld()->GetSubsystem<USideScrollingCameraBoundsSubsystem>())
+		{
+			if (const ASideScrollingCameraBounds* FoundBounds = BoundsSubsystem->FindBounds(CurrentActorLocation.X))
+			{
+				ActiveBounds = FoundBounds;
+			}
+		}
+
+		const ASideScrollingCameraBounds* Bounds = ActiveBounds.Get();
+
 		// calculate the "zoom distance" - in reality the distance we want to keep to the target
-		float CurrentY = CurrentZoom + CurrentActorLocation.Y;
+		float CurrentY = (Bounds ? Bounds->GetZoom(CurrentZoom) : CurrentZoom) + CurrentActorLocation.Y;
 
 		// do first-time setup
 		if (bSetup)
@@ -42,6 +60,20 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 			// save the current camera height
 			CurrentZ = OutVT.POV.Location.Z;
 
+			// find the level's ground profile, if any
+			for (TActorIterator<ASideScrollingGroundProfile> It(GetWorld()); It; ++It)
+			{
+				GroundProfile = *It;
+				break;
+			}
+
+			// find the level's chunk streamer, if any
+			for (TActorIterator<ASideScrollingLevelStreamer> It(GetWorld()); It; ++It)
+			{
+				LevelStreamer = *It;
+				break;
+			}
+
 			// skip the rest of the calculations
 			return;
 		}
@@ -57,16 +89,8 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 
 		} else {
 
-			// run a trace below the character to determine if we need to do a height update
-			FHitResult OutHit;
-
-			const FVector End = CurrentActorLocation + FVector(0.0f, 0.0f, -1000.0f);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(TargetPawn);
-
 			// only update height if we're not about to hit ground
-			bZUpdate = !GetWorld()->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+			bZUpdate = !IsGroundBelow(CurrentActorLocation, 1000.0f, TargetPawn);
 
 		}
 
@@ -94,12 +118,83 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 
 		}
 
-		// clamp the X axis to the min and max camera bounds
-		float CurrentX = FMath::Clamp(CurrentActorLocation.X, CameraXMinBounds, CameraXMaxBounds);
+		// clamp the camera X to the min and max camera bounds
+		FFloatInterval XRange(CameraXMinBounds, CameraXMaxBounds);
+		float TargetZ = CurrentZ;
+
+		if (Bounds)
+		{
+			// narrow the range so the edges of the view stop at the edges of the section
+			const float HalfViewWidth = (CurrentY - CurrentActorLocation.Y) * FMath::Tan(FMath::DegreesToRadians(OutVT.POV.FOV * 0.5f));
+			const FFloatInterval SectionRange = Bounds->GetXRange();
+
+			XRange.Min = FMath::Max(XRange.Min, SectionRange.Min + HalfViewWidth);
+			XRange.Max = FMath::Min(XRange.Max, SectionRange.Max - HalfViewWidth);
+
+			// clamp the height goal to the volume
+			TargetZ = Bounds->ClampZ(CurrentZ);
+		}
+
+		// center the camera on sections narrower than the view
+		const float CurrentX = XRange.Min <= XRange.Max ? FMath::Clamp(CurrentActorLocation.X, XRange.Min, XRange.Max) : 0.5f * (XRange.Min + XRange.Max);
 
 		// blend towards the new camera location and update the output
-		FVector TargetCameraLocation(CurrentX, CurrentY, CurrentZ);
+		FVector TargetCameraLocation(CurrentX, CurrentY, TargetZ);
 
 		OutVT.POV.Location = FMath::VInterpTo(CurrentCameraLocation, TargetCameraLocation, DeltaTime, 2.0f);
+
+		// stream level chunks ahead of where we're scrolling
+		if (ASideScrollingLevelStreamer* Streamer = LevelStreamer.Get())
+		{
+			Streamer->UpdateStreaming(OutVT.POV.Location.X, TargetPawn->GetVelocity().X);
+		}
+
+		// slide the activation window with the camera so off-screen actors can sleep
+		if (USideScrollingActivationSubsystem* Activation = GetWorld()->GetSubsystem<USideScrollingActivationSubsystem>())
+		{
+			const float HalfViewWidth = FMath::Abs(OutVT.POV.Location.Y - CurrentActorLocation.Y) * FMath::Tan(FMath::DegreesToRadians(OutVT.POV.FOV * 0.5f));
+			const float HalfWindowWidth = HalfViewWidth + ActivationMargin;
+
+			Activation->UpdateWindow(OutVT.POV.Location.X - HalfWindowWidth, OutVT.POV.Location.X + HalfWindowWidth);
+		}
 	}
-}
\ No newline at end of file
+}
+
+bool ASideScrollingCameraManager::IsGroundBelow(const FVector& Location, float MaxDistance, const AActor* IgnoredActor) const
+{
+	// look up the baked profile first
+	if (const ASideScrollingGroundProfile* Profile = GroundProfile.Get())
+	{
+		switch (Profile->FindGroundBelow(Location, MaxDistance))
+		{
+		case ESideScrollingGroundLookup::Ground:
+			return true;
+
+		case ESideScrollingGroundLookup::NoGround:
+			return false;
+
+		default:
+			break;
+		}
+	}
+
+	// the profile can't answer here, so run a trace below the location
+	FHitResult OutHit;
+
+	const FVector End = Location + FVector(0.0f, 0.0f, -MaxDistance);
+
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(IgnoredActor);
+
+	return GetWorld()->LineTraceSingleByChannel(OutHit, Location, End, ECC_Visibility, QueryParams);
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void ASideScrollingCameraManager::UpdateViewTargetForTesting(FTViewTarget& OutVT, float DeltaTime)
+{
+	UpdateViewTarget(OutVT, DeltaTime);
+
+	// cache the result so the next update blends from it, like a regular camera update would
+	FillCameraCache(OutVT.POV);
+}
+#endif
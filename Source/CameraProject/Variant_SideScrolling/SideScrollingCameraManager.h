@@ -6,8 +6,14 @@
 #include "Camera/PlayerCameraManager.h"
 #include "SideScrollingCameraManager.generated.h"
 
+class ASideScrollingCameraBounds;
+class ASideScrollingGroundProfile;
+class ASideScrollingLevelStreamer;
+
 /**
- *  Simple side scrolling camera with smooth scrolling and horizontal bounds
+ *  Simple side scrolling camera with smooth scrolling and horizontal bounds.
+ *  Camera bounds volumes placed in the level narrow the bounds and override the height clamp and zoom per section.
+ *  The view stops at the edges of the current section until the target enters a different one.
  */
 UCLASS()
 class ASideScrollingCameraManager : public APlayerCameraManager
@@ -19,6 +25,11 @@ public:
 	/** Overrides the default camera view target calculation */
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	/** Runs a view target update and caches the result, without a player controller driving the camera. Used by automation tests */
+	void UpdateViewTargetForTesting(FTViewTarget& OutVT, float DeltaTime);
+#endif
+
 public:
 
 	/** How close we want to stay to the view target */
@@ -29,14 +40,18 @@ public:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
 	float CameraZOffset = 100.0f;
 
-	/** Minimum camera scrolling bounds in world space */
+	/** Minimum camera scrolling bounds in world space. Camera bounds volumes can only narrow them */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
 	float CameraXMinBounds = -400.0f;
 
-	/** Maximum camera scrolling bounds in world space */
+	/** Maximum camera scrolling bounds in world space. Camera bounds volumes can only narrow them */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
 	float CameraXMaxBounds = 10000.0f;
 
+	/** Distance past the edges of the view where actors stay active. Actors further away are put to sleep */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float ActivationMargin = 1500.0f;
+
 protected:
 
 	/** Last cached camera vertical location. The camera only adjusts its height if necessary. */
@@ -44,4 +59,16 @@ protected:
 
 	/** First-time update camera setup flag */
 	bool bSetup = true;
+
+	/** Camera bounds volume of the section the target was last in */
+	TWeakObjectPtr<const ASideScrollingCameraBounds> ActiveBounds;
+
+	/** Baked ground profile for the current level, if it has one. Replaces most ground traces with a lookup */
+	TWeakObjectPtr<ASideScrollingGroundProfile> GroundProfile;
+
+	/** Level chunk streamer for the current level, if it's split into chunks */
+	TWeakObjectPtr<ASideScrollingLevelStreamer> LevelStreamer;
+
+	/** Returns true if there's ground within MaxDistance below the location. Uses the ground profile when it can, falls back to a trace otherwise */
+	bool IsGroundBelow(const FVector& Location, float MaxDistance, const AActor* IgnoredActor) const;
 };